@@ -0,0 +1,54 @@
+#include "Engine/Frustum.hpp"
+#include <cmath>
+
+Frustum Frustum::fromViewProj(const glm::mat4& viewProj)
+{
+    Frustum frustum;
+
+    // rows of the matrix (glm is column-major)
+    const glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+    const glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+    const glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+    const glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+    frustum.planes[0] = row3 + row0; // left
+    frustum.planes[1] = row3 - row0; // right
+    frustum.planes[2] = row3 + row1; // bottom
+    frustum.planes[3] = row3 - row1; // top
+    frustum.planes[4] = row3 + row2; // near
+    frustum.planes[5] = row3 - row2; // far
+
+    for (glm::vec4& plane : frustum.planes)
+    {
+        const float len = glm::length(glm::vec3(plane));
+        if (len > 0.0f)
+            plane /= len;
+    }
+    return frustum;
+}
+
+bool Frustum::intersectsAABB(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& model) const
+{
+    const glm::vec3 localCenter = (localMin + localMax) * 0.5f;
+    const glm::vec3 localExtent = (localMax - localMin) * 0.5f;
+
+    // world-space box enclosing the transformed local box
+    const glm::vec3 center = glm::vec3(model * glm::vec4(localCenter, 1.0f));
+    glm::vec3 extent(0.0f);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        extent[axis] = std::abs(model[0][axis]) * localExtent.x
+                     + std::abs(model[1][axis]) * localExtent.y
+                     + std::abs(model[2][axis]) * localExtent.z;
+    }
+
+    for (const glm::vec4& plane : planes)
+    {
+        const glm::vec3 n(plane);
+        const float distance = glm::dot(n, center) + plane.w;
+        const float radius = glm::dot(glm::abs(n), extent);
+        if (distance + radius < 0.0f)
+            return false;
+    }
+    return true;
+}
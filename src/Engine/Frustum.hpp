@@ -0,0 +1,19 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <array>
+
+// Six clip planes extracted from a view-projection matrix, used to cull
+// objects before they are submitted for drawing.
+class Frustum
+{
+public:
+    static Frustum fromViewProj(const glm::mat4& viewProj);
+
+    // local-space box transformed by model; conservative (may keep boxes
+    // that are just outside a corner of the frustum)
+    bool intersectsAABB(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& model) const;
+
+private:
+    // xyz = normal pointing inside, w = distance
+    std::array<glm::vec4, 6> planes{};
+};
@@ -0,0 +1,95 @@
+#include "Engine/GpuPicker.hpp"
+#include "Engine/OpenGLContext.hpp"
+#include "Engine/ShaderLibrary.hpp"
+#include "Engine/Frustum.hpp"
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include <glad/glad.h>
+#include <limits>
+
+bool GpuPicker::pick(OpenGLContext& ctx, const std::list<ThreeDObject*>& objects,
+    const glm::mat4& view, const glm::mat4& projection, PickTarget target,
+    int x, int y, int viewportWidth, int viewportHeight, PickHit& outHit)
+{
+    outHit = PickHit{};
+    if (viewportWidth <= 0 || viewportHeight <= 0)
+        return false;
+
+    // the framebuffer is stretched over the viewport, so map into its pixels
+    const int fbX = x * ctx.getWidth() / viewportWidth;
+    const int fbY = y * ctx.getHeight() / viewportHeight;
+
+    ctx.bindForPicking();
+    ShaderLibrary::get().updateCameraBlock(view, projection);
+
+    // ids must reach the attachment unblended, the caller's blend state is put back after
+    const GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    const Frustum frustum = Frustum::fromViewProj(projection * view);
+    glm::vec3 boundsMin, boundsMax;
+
+    pickMeshes.clear();
+    for (ThreeDObject* obj : objects)
+    {
+        if (!obj || !obj->isSelectable() || !obj->getIsMesh()) continue;
+
+        Mesh* mesh = static_cast<Mesh*>(obj);
+        const glm::mat4 model = mesh->getModelMatrix();
+        if (mesh->getLocalBounds(boundsMin, boundsMax) && !frustum.intersectsAABB(boundsMin, boundsMax, model))
+            continue;
+
+        pickMeshes.push_back(mesh);
+        mesh->renderPick(target, static_cast<uint32_t>(pickMeshes.size()));
+    }
+
+    if (blendWasEnabled)
+        glEnable(GL_BLEND);
+
+    // vertex handles and lines are small on screen, so accept a few pixels of slack
+    const int radius = (target == PickTarget::Face) ? 0 : (target == PickTarget::Vertice ? 6 : 4);
+
+    glm::ivec4 rect;
+    const bool readOk = ctx.readPickRect(fbX, fbY, radius, readback, rect);
+    ctx.unbind();
+    if (!readOk)
+        return true;
+
+    // nearest non-empty pixel to the cursor wins
+    int bestDist = std::numeric_limits<int>::max();
+    glm::uvec2 best(0);
+    for (int row = 0; row < rect.w; ++row)
+    {
+        for (int col = 0; col < rect.z; ++col)
+        {
+            const glm::uvec2 id = readback[static_cast<size_t>(row) * rect.z + col];
+            if (id.x == 0 || id.y == 0) continue;
+
+            const int dx = rect.x + col - fbX;
+            const int dy = rect.y + row - fbY;
+            const int dist = dx * dx + dy * dy;
+            if (dist < bestDist)
+            {
+                bestDist = dist;
+                best = id;
+            }
+        }
+    }
+
+    if (best.x == 0 || best.x > pickMeshes.size())
+        return true;
+
+    Mesh* mesh = pickMeshes[best.x - 1];
+    const uint32_t element = best.y - 1;
+    const MeshRenderCache& cache = mesh->getRenderCache();
+
+    outHit.mesh = mesh;
+    outHit.elementIndex = element;
+    switch (target)
+    {
+    case PickTarget::Vertice: outHit.vertice = cache.getPickedVertice(element); break;
+    case PickTarget::Edge:    outHit.edge = cache.getPickedEdge(element); break;
+    case PickTarget::Face:    outHit.face = cache.getPickedFace(element); break;
+    }
+    return true;
+}
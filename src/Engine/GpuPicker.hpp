@@ -0,0 +1,35 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <list>
+#include <vector>
+#include "WorldObjects/Mesh/MeshRenderCache.hpp"
+
+class OpenGLContext;
+class ThreeDObject;
+class Mesh;
+
+struct PickHit
+{
+    Mesh* mesh = nullptr;
+    Vertice* vertice = nullptr;
+    Edge* edge = nullptr;
+    Face* face = nullptr;
+    uint32_t elementIndex = UINT32_MAX; // draw-order index inside mesh's render cache
+};
+
+// Offscreen id pass : renders (object, element) ids of every visible mesh into
+// the integer attachment of the OpenGLContext framebuffer and reads back only
+// the few pixels under the cursor. Cost does not depend on mesh size and
+// hidden elements are never returned.
+class GpuPicker
+{
+public:
+    // x, y are viewport pixels with a bottom-left origin
+    bool pick(OpenGLContext& ctx, const std::list<ThreeDObject*>& objects,
+        const glm::mat4& view, const glm::mat4& projection, PickTarget target,
+        int x, int y, int viewportWidth, int viewportHeight, PickHit& outHit);
+
+private:
+    std::vector<Mesh*> pickMeshes;
+    std::vector<glm::uvec2> readback;
+};
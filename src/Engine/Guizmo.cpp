@@ -60,7 +60,7 @@ const glm::mat4& view, const glm::mat4& proj, ImVec2 oglChildPos, ImVec2 oglChil
     {
         if (!v) continue;
         ThreeDObject* parent = v->getMeshParent();
-        glm::vec3 lp = v->getPosition();
+        glm::vec3 lp = v->getLocalPosition();
         glm::vec4 wp = parent ? (parent->getModelMatrix() * glm::vec4(lp, 1.0f)) : glm::vec4(lp, 1.0f);
         center += glm::vec3(wp);
         ++count;
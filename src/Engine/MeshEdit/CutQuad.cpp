@@ -1,7 +1,3 @@
-#include <glm/vec4.hpp>
-
-// Prototype
-void markLonelyEdgesRed(class Mesh* mesh);
 #include "Engine/MeshEdit/CutQuad.hpp"
 #include "WorldObjects/Basic/Edge.hpp"
 #include "WorldObjects/Mesh/Mesh.hpp"
@@ -12,579 +8,198 @@ void markLonelyEdgesRed(class Mesh* mesh);
 #include <unordered_set>
 #include <iostream>
 #include <algorithm>
-#include "Engine/ErrorBox.hpp"
 
-namespace MeshEdit 
+namespace MeshEdit
 {
-
-	void CutQuad(const std::vector<Edge*>& loop, Mesh* mesh, const std::vector<Quad*>& traversedQuads)
+	namespace
 	{
-
-		std::vector<Vertice*> centers;
-		std::vector<Vertice*> firstRing;
-		std::vector<Edge*> QuadEdges;
-		std::vector<Edge*> firstRowEdges;
-
-		// First step : Create the center vertices
-		for (Edge* edge : loop) 
+		// edge registered on both its vertices, like the rest of the mesh expects
+		Edge* addLinkedEdge(Mesh* mesh, Vertice* a, Vertice* b)
 		{
-			if (!edge || !mesh) continue;
-			Vertice* v1 = edge->getStart();
-			Vertice* v2 = edge->getEnd();
-			if (!v1 || !v2) continue;
-
-			glm::vec3 pos1 = v1->getLocalPosition();
-			glm::vec3 pos2 = v2->getLocalPosition();
-
-			glm::vec3 mid = (pos1 + pos2) * 0.5f;
-			Vertice* centerVert = mesh->addVertice(mid);
-
-			if (centerVert) 
-			{
-				centerVert->initialize();
-				centers.push_back(centerVert);
-			}
+			Edge* e = mesh->addEdge(a, b);
+			a->addEdge(e);
+			b->addEdge(e);
+			return e;
 		}
 
-		// Second step : split the edges
-		for (size_t i = 0; i < loop.size() && i < centers.size(); ++i)
+		int cornerOf(const std::array<Vertice*, 4>& corners, const Vertice* v)
 		{
-			Edge* edge = loop[i];
-			Vertice* centerVert = centers[i];
-			if (edge && centerVert && mesh)
-			{
-				Vertice* v1 = edge->getStart();
-				Vertice* v2 = edge->getEnd();
-				
-				edge->splitEdge(centerVert, mesh);
-				
-				Edge* e1 = nullptr;
-				Edge* e2 = nullptr;
-				for (Edge* e : mesh->getEdges())
-				{
-					if (!e) continue;
-					if ((e->getStart() == v1 && e->getEnd() == centerVert) || 
-						(e->getStart() == centerVert && e->getEnd() == v1))
-					{
-						e1 = e;
-					}
-					if ((e->getStart() == centerVert && e->getEnd() == v2) || 
-						(e->getStart() == v2 && e->getEnd() == centerVert))
-					{
-						e2 = e;
-					}
-				}
-				
-				if (e1) centerVert->addEdge(e1);
-				if (e2) centerVert->addEdge(e2);
-				
-				if (e1) v1->addEdge(e1);
-				if (e2) v2->addEdge(e2);
-			}
-		}		
-
-		std::vector<Edge*> centerEdges;
-
-		// Third step : draw the centers edges to connect the center vertices
-		if (mesh && centers.size() > 1) 
-		{
-			for (size_t i = 0; i < centers.size() - 1; ++i)
-			{
-				Vertice* vStart = centers[i];
-				Vertice* vEnd = centers[i + 1];
-
-				if (vStart && vEnd) 
-				{
-					Edge* newEdge = mesh->addEdge(vStart, vEnd);
-
-					if (newEdge) 
-					{
-						newEdge->initialize();
-
-						centerEdges.push_back(newEdge);
-						vStart->addEdge(newEdge);
-						vEnd->addEdge(newEdge);
-
-					}
-				}
-			}
-
-			Vertice* vFirst = centers.front();
-			Vertice* vLast = centers.back();
-
-			// here i set the color of the first and last center vertices for debug
-			// vFirst->setColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-			// vLast->setColor(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
-			
-			// close the loop of center edges
-			if (vFirst && vLast) 
-			{
-				Edge* closingEdge = mesh->addEdge(vLast, vFirst);
-				if (closingEdge) 
-				{
-					closingEdge->initialize();
-					centerEdges.push_back(closingEdge);
-					vLast->addEdge(closingEdge);
-					vFirst->addEdge(closingEdge);
-				}
-			}
+			for (int i = 0; i < 4; ++i)
+				if (corners[i] == v) return i;
+			return -1;
 		}
 
-		std::unordered_set<std::string> centerEdgeIDs;
-
-		// --- color in red the center edges that have no shared faces
-		for (Edge* edge : centerEdges)
+		// side of the quad joining a and b, looked up in the mesh for quads built without edges
+		Edge* sideOf(Mesh* mesh, const std::array<Edge*, 4>& sides, const Vertice* a, const Vertice* b)
 		{
-			if (!edge) continue;
-			auto& sharedFaces = edge->getSharedFacesNonConst();
-			if (sharedFaces.empty())
+			for (Edge* e : sides)
 			{
-				centerEdgeIDs.insert(edge->getID());
+				if (e && ((e->getStart() == a && e->getEnd() == b) || (e->getStart() == b && e->getEnd() == a)))
+					return e;
 			}
+			return mesh->findEdge(a, b);
 		}
 
-
-		findFirstQuadEdgesWithVertice(centers, centerEdgeIDs, centerEdges, mesh, firstRowEdges, QuadEdges);
-
-		// Clean up : remove the traversed quads from the mesh and from the edges shared faces
-		for (Quad* quad : traversedQuads)
+		// one crossed quad and the two ring edges it holds, as slots in the ring
+		struct Crossing
 		{
-			const std::array<Edge*, 4>& quadEdges = quad->getEdgesArray();
-			for (Edge* edge : quadEdges)
-			{
-				if (!edge) continue;
-				auto& sharedFaces = edge->getSharedFacesNonConst();
-				auto itFace = std::find(sharedFaces.begin(), sharedFaces.end(), quad);
-				if (itFace != sharedFaces.end())
-				{
-					sharedFaces.erase(itFace);
-				}
-			}
-		}
-		
-		// Retire the quads from the mesh
-		if (mesh)
-		{
-			auto& meshFaces = mesh->getFacesNonConst();
-			for (Quad* quad : traversedQuads)
-			{
-				auto it = std::find(meshFaces.begin(), meshFaces.end(), quad);
-				if (it != meshFaces.end())
-				{
-					meshFaces.erase(it);
-				}
-				quad->destroy();
-				delete quad;
-			}
-		}
-
-		// ----------------------------
-
-	
-		// // ------------------------------
-		// // Update MeshDNA quad count
-		// if (mesh && mesh->getMeshDNA())
-		// {
-		// 	MeshDNA* mdna = mesh->getMeshDNA();
-		// 	int currentQuadCount = mesh->getQuads().size();
-			
-		// 	std::cout << "[CutQuad] Updated MeshDNA quad count to: " << currentQuadCount << std::endl;
-		// 	mdna->setQuadCount(currentQuadCount);	
-		// }
+			Quad* quad = nullptr;
+			size_t a = 0;
+			size_t b = 0;
+		};
 	}
 
-	void findFirstQuadEdgesWithVertice(const std::vector<Vertice*>& centers, const std::unordered_set<std::string>& centerEdgeIDs, 
-	const std::vector<Edge*>& centerEdges, Mesh* mesh, std::vector<Edge*>& firstRowEdges, std::vector<Edge*>& QuadEdges)
+	void CutQuad(const std::vector<Edge*>& loop, Mesh* mesh, const std::vector<Quad*>& traversedQuads, int cuts)
 	{
-		// ------- find the next vertice
-		glm::vec3 cutDir = glm::normalize(centers.back()->getLocalPosition() - centers.front()->getLocalPosition());		
-		glm::vec3 refDir = glm::vec3(0.0f);
+		if (!mesh || loop.empty() || traversedQuads.empty()) return;
+		const size_t n = static_cast<size_t>(std::max(cuts, 1));
 
-		for (Vertice* cv : centers)
+		// ---- ring edges, each once ---- //
+		std::vector<Edge*> ringEdges;
+		std::unordered_map<const Edge*, size_t> ringSlot;
+		ringEdges.reserve(loop.size());
+		ringSlot.reserve(loop.size());
+		for (Edge* edge : loop)
 		{
-			if (!cv) continue;
-
-			for (Edge* e : cv->getEdges())
-			{
-				if (!e || centerEdgeIDs.find(e->getID()) != centerEdgeIDs.end()) continue;
-
-				Vertice* next = (e->getStart() == cv) ? e->getEnd() : e->getStart();
-
-				if (next)
-				{
-					refDir = glm::normalize(next->getLocalPosition() - cv->getLocalPosition());
-					break;
-				}
-			}
-			if (glm::length(refDir) > 0.01f) break;
+			if (!edge || !edge->getStart() || !edge->getEnd()) continue;
+			if (ringSlot.emplace(edge, ringEdges.size()).second)
+				ringEdges.push_back(edge);
 		}
-		
-		
-		glm::vec3 normalDir = glm::normalize(glm::cross(cutDir, refDir));
 
-		// operation fo the current center vertice, the the current vert will be the departure point to build the quad
-		for (int i = 0; i < centers.size(); ++i)
+		std::unordered_set<const Face*> crossed;
+		std::vector<Crossing> crossings;
+		crossed.reserve(traversedQuads.size());
+		crossings.reserve(traversedQuads.size());
+		for (Quad* quad : traversedQuads)
 		{
-			Edge* currentPerpendicularEdge = nullptr;
-			Vertice* currentVert = centers[i];			
-			if (!currentVert) continue;
+			if (!quad || !crossed.insert(quad).second) continue;
 
-			const auto& connectedEdges = currentVert->getEdges();
-
-			for (Edge* edge : connectedEdges)
+			Crossing c;
+			c.quad = quad;
+			int found = 0;
+			for (Edge* e : quad->getEdgesArray())
 			{
-				if (!edge) continue;
-
-
-				// i decided to start finding the perpendicular edges using centerEdgs as reference
-				bool isNotCenterEdge = (centerEdgeIDs.find(edge->getID()) == centerEdgeIDs.end());
-				if (isNotCenterEdge)
-				{
-
-					// the vector 3 edgeDir give us the the direction of the edge connected to the current center vertice
-					Vertice* otherVert = (edge->getStart() == currentVert) ? edge->getEnd() : edge->getStart();
-					glm::vec3 edgeDir = glm::normalize(otherVert->getLocalPosition() - currentVert->getLocalPosition());
-					float dot = glm::dot(edgeDir, refDir);
-
-					// i decided to start from the part that inferior to zero, remember we have found the perpendicular edges to the cut direction
-					if (dot < 0.0f)
-					{
-						if(edge->hasbeenMarkedOnceInCutQuad == false)
-						{
-							// edge->setColor(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)); 
-							firstRowEdges.push_back(edge);
-						}
-						
-						// ---- Departure point to build the quad
-						// ----------- here we find the first edge of the quad
-						if (i == 0)
-						{
-							// edge->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
-							edge->hasbeenMarkedOnceInCutQuad = true;
-							currentPerpendicularEdge = edge;
-							QuadEdges.push_back(currentPerpendicularEdge);							
-						}
-					}
-				}
+				auto it = ringSlot.find(e);
+				if (it == ringSlot.end()) continue;
+				(found == 0 ? c.a : c.b) = it->second;
+				++found;
 			}
-			
-		
-			// here we check for the next vertice and we find the edge connecting current vert and next center vert
-			if (i == 0)
-			{
-
-				// ---------- 1 : find the next vertice
-				size_t nextIndex = (i + 1) % centers.size();
-				Vertice* nextVert = centers[nextIndex];
-				Edge* nextPerpendicularEdge = nullptr;
-				Vertice* nextPerpendicularEdgeEndVertice = nullptr;
-
-				// ------------------ 2 Find the connected edge witch is also a center edge, the second edge
-				Edge* connectingEdge = nullptr;
-
-				for (Edge* e : centerEdges)
-				{
-					if (!e) continue;
-					Vertice* start = e->getStart();
-					Vertice* end = e->getEnd();
-
-					if ((start == currentVert && end == centers[nextIndex]) || (start == centers[nextIndex] && end == currentVert))
-					{
-						connectingEdge = e;
-						break;
-					}
-				}
-
-				// for the debug, we color in green the center edge connecting the first and second center vertice
-				if (connectingEdge && connectingEdge->hasbeenMarkedOnceInCutQuad == false)
-				{
-					// connectingEdge->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
-					connectingEdge->hasbeenMarkedOnceInCutQuad = true;
-
-					// now we have the second edge of the first quad
-					QuadEdges.push_back(connectingEdge);
-
-				}
-
-				// -------------- 3 : Find the  perpendicular edge to the vertice marqued by the next index
-				for (Edge* e : nextVert->getEdges())
-				{
-
-					if (!e || centerEdgeIDs.find(e->getID()) != centerEdgeIDs.end()) 
-					continue;
-					
-					Vertice* other = (e->getStart() == nextVert) ? e->getEnd() : e->getStart();
-					
-					if (!other) continue;
-						
-					glm::vec3 edgeDir = glm::normalize(other->getLocalPosition() - nextVert->getLocalPosition());
-					float dot = glm::dot(edgeDir, refDir);
-
-					if (dot < 0.0f)
-					{
-						// e->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)); 
-						e->hasbeenMarkedOnceInCutQuad = true;
-						nextPerpendicularEdge = e;
-						QuadEdges.push_back(nextPerpendicularEdge);
-						break;
-					}
-				}
-
-				//--------- 4 : find the fourth edge of the quad
-				if(currentPerpendicularEdge != nullptr && nextPerpendicularEdge != nullptr)
-				{
-
-					Vertice* vA = (currentPerpendicularEdge->getStart() == currentVert) ? currentPerpendicularEdge->getEnd() : currentPerpendicularEdge->getStart();
-					Vertice* vB = (nextPerpendicularEdge->getStart() == nextVert) ? nextPerpendicularEdge->getEnd() : nextPerpendicularEdge->getStart();
-
-					Edge* fourthEdge = nullptr;
-
-					for (Edge* e : vA->getEdges()) 
-					{
-						if (!e || centerEdgeIDs.find(e->getID()) != centerEdgeIDs.end()) continue;
-						if ((e->getStart() == vA && e->getEnd() == vB) || (e->getStart() == vB && e->getEnd() == vA)) {
-							fourthEdge = e;
-							break;
-						}
-					}
-
-					if (fourthEdge) 
-					{
-						// fourthEdge->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
-						fourthEdge->hasbeenMarkedOnceInCutQuad = true;
-						QuadEdges.push_back(fourthEdge);
-					}
-				}
-
-				// -------- create the quad
-				buildQuadFromEdges(QuadEdges, currentVert, nextVert, mesh);
-
-				std::cout << "[buildFirstQuadfromVertice] Cleaning hasbeenMarkedOnceInCutQuad flags..." << std::endl;
-				for (Edge* e : mesh->getEdges())
-				{
-					if (e) 
-					{
-						e->hasbeenMarkedOnceInCutQuad = false;
-					}
-				}
-
-				// -------- Now try to find the edges for the second quad (index 1)
-				findNextQuadEdgesForFirstRow(centers, centerEdgeIDs, centerEdges, mesh, QuadEdges, refDir, 1);
 
+			if (found != 2)
+			{
+				std::cerr << "[CutQuad] quad holds " << found << " ring edges instead of 2, cut skipped" << std::endl;
+				return;
 			}
+			crossings.push_back(c);
 		}
 
-		// ------------- End of the operation for the vertice
-	}
-
-	void findNextQuadEdgesForFirstRow(const std::vector<Vertice*>& centers, const std::unordered_set<std::string>& centerEdgeIDs, 
-	const std::vector<Edge*>& centerEdges, Mesh* mesh, std::vector<Edge*>& QuadEdges, const glm::vec3& refDir, int currentIndex)
-	{
-		QuadEdges.clear();
-
-		if (currentIndex < 0 || currentIndex >= static_cast<int>(centers.size())) 
-		{
-			return;
-		}
-
-		Vertice* currentVert = centers[currentIndex];
-		size_t nextIndex = (currentIndex + 1) % centers.size();
-		Vertice* nextVert = centers[nextIndex];
-
-		if (!currentVert || !nextVert) 
-		{
-			return;
-		}
-
-
-
-		// ---------- 1: Find the first perpendicular edge (connected to currentVert)
-		// This edge can already be marked because it's shared with the previous quad
-
-		Edge* currentPerpendicularEdge = nullptr;
-		const auto& connectedEdges = currentVert->getEdges();
-
-		for (Edge* edge : connectedEdges)
+		// a face outside the ring on a ring edge would be left with a T-junction
+		for (Edge* edge : ringEdges)
 		{
-			if (!edge) continue;
-
-			// Skip if it's a center edge
-			bool isNotCenterEdge = (centerEdgeIDs.find(edge->getID()) == centerEdgeIDs.end());
-			if (!isNotCenterEdge) continue;
-
-			Vertice* otherVert = (edge->getStart() == currentVert) ? edge->getEnd() : edge->getStart();
-			if (!otherVert) continue;
-
-			glm::vec3 edgeDir = glm::normalize(otherVert->getLocalPosition() - currentVert->getLocalPosition());
-			float dot = glm::dot(edgeDir, refDir);
-
-			if (dot < 0.0f)
+			for (Face* f : edge->getSharedFaces())
 			{
-				edge->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
-				currentPerpendicularEdge = edge;
-				QuadEdges.push_back(currentPerpendicularEdge);
-				break;
+				if (f && crossed.count(f) == 0)
+				{
+					std::cerr << "[CutQuad] ring edge borders a face outside the ring, cut skipped" << std::endl;
+					return;
+				}
 			}
 		}
 
-		if (!currentPerpendicularEdge)
-		{
-			return;
-		}
+		mesh->beginEdit();
 
-		// ---------- 2: Find the connecting center edge
-		Edge* connectingEdge = nullptr;
-		for (Edge* e : centerEdges)
+		const size_t ringCount = ringEdges.size();
+		mesh->reserve(ringCount * n, ringCount * (n + 1) + crossings.size() * n, crossings.size() * (n + 1));
+
+		// ---- n evenly spaced points on every ring edge, start to end ---- //
+		// rail i holds the start vertex, the n new points and the end vertex
+		const size_t railSize = n + 2;
+		std::vector<Vertice*> rails(ringCount * railSize);
+		for (size_t i = 0; i < ringCount; ++i)
 		{
-			if (!e) continue;
-			Vertice* start = e->getStart();
-			Vertice* end = e->getEnd();
+			Vertice* start = ringEdges[i]->getStart();
+			Vertice* end = ringEdges[i]->getEnd();
+			const glm::vec3 from = start->getLocalPosition();
+			const glm::vec3 to = end->getLocalPosition();
 
-			if ((start == currentVert && end == nextVert) || (start == nextVert && end == currentVert))
-			{
-				connectingEdge = e;
-				break;
-			}
+			Vertice** rail = &rails[i * railSize];
+			rail[0] = start;
+			rail[n + 1] = end;
+			for (size_t k = 1; k <= n; ++k)
+				rail[k] = mesh->addVertice(glm::mix(from, to, static_cast<float>(k) / static_cast<float>(n + 1)));
 		}
 
-		if (connectingEdge)
-		{
-			connectingEdge->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)); // Green for debug
-			if (connectingEdge->hasbeenMarkedOnceInCutQuad == false)
-			{
-				connectingEdge->hasbeenMarkedOnceInCutQuad = true;
-			}
-			QuadEdges.push_back(connectingEdge);
-		}
-		else
+		// ---- the ring edges are replaced by n + 1 segments each ---- //
+		std::vector<Edge*> segments(ringCount * (n + 1));
+		for (size_t i = 0; i < ringCount; ++i)
 		{
-			return;
+			for (size_t k = 0; k <= n; ++k)
+				segments[i * (n + 1) + k] = addLinkedEdge(mesh, rails[i * railSize + k], rails[i * railSize + k + 1]);
 		}
 
-		// ---------- 3: Find the perpendicular edge on the next vertex
-		Edge* nextPerpendicularEdge = nullptr;
-		for (Edge* e : nextVert->getEdges())
+		// ---- every crossed quad becomes a strip of n + 1 quads ---- //
+		std::vector<Edge*> rungs(n + 2);
+		for (const Crossing& c : crossings)
 		{
-			if (!e || centerEdgeIDs.find(e->getID()) != centerEdgeIDs.end()) 
-				continue;
-			
-			Vertice* other = (e->getStart() == nextVert) ? e->getEnd() : e->getStart();
-			if (!other) continue;
-				
-			glm::vec3 edgeDir = glm::normalize(other->getLocalPosition() - nextVert->getLocalPosition());
-			float dot = glm::dot(edgeDir, refDir);
+			const std::array<Vertice*, 4> corners = c.quad->getVerticesArray();
+			const std::array<Edge*, 4> sides = c.quad->getEdgesArray();
 
-			// We stay in the same direction (dot < 0.0f)
-			if (dot < 0.0f)
-			{
-				if (e->hasbeenMarkedOnceInCutQuad == false)
-				{
-					e->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)); // Green for debug
-					e->hasbeenMarkedOnceInCutQuad = true;
-					nextPerpendicularEdge = e;
-					QuadEdges.push_back(nextPerpendicularEdge);
-					break;
-				}
-			}
-		}
+			Vertice* const* railA = &rails[c.a * railSize];
+			Vertice* const* railB = &rails[c.b * railSize];
 
-		if (!nextPerpendicularEdge)
-		{
-			return;
-		}
+			// rail b runs alongside rail a when its start sits next to a's start
+			const int startA = cornerOf(corners, railA[0]);
+			const int startB = cornerOf(corners, railB[0]);
+			const bool flipped = startA < 0 || startB < 0 || (startA - startB + 4) % 4 == 2;
 
-		// ---------- 4: Find the fourth edge (parallel to the center edge)
-		Vertice* vA = (currentPerpendicularEdge->getStart() == currentVert) ? currentPerpendicularEdge->getEnd() : currentPerpendicularEdge->getStart();
-		Vertice* vB = (nextPerpendicularEdge->getStart() == nextVert) ? nextPerpendicularEdge->getEnd() : nextPerpendicularEdge->getStart();
+			auto pointA = [&](size_t k) { return railA[k]; };
+			auto pointB = [&](size_t k) { return railB[flipped ? n + 1 - k : k]; };
+			auto segmentA = [&](size_t k) { return segments[c.a * (n + 1) + k]; };
+			auto segmentB = [&](size_t k) { return segments[c.b * (n + 1) + (flipped ? n - k : k)]; };
 
-		Edge* fourthEdge = nullptr;
-		for (Edge* e : vA->getEdges()) 
-		{
-			if (!e || centerEdgeIDs.find(e->getID()) != centerEdgeIDs.end()) continue;
-			
-			if ((e->getStart() == vA && e->getEnd() == vB) || (e->getStart() == vB && e->getEnd() == vA)) 
+			// the outer rungs are the quad's own sides, the inner ones are the new loops
+			rungs[0] = sideOf(mesh, sides, pointA(0), pointB(0));
+			rungs[n + 1] = sideOf(mesh, sides, pointA(n + 1), pointB(n + 1));
+			for (size_t k = 1; k <= n; ++k)
+				rungs[k] = addLinkedEdge(mesh, pointA(k), pointB(k));
+
+			// keep the winding of the quad being replaced
+			const bool forward = startA >= 0 && corners[(startA + 1) % 4] == pointA(n + 1);
+			for (size_t k = 0; k <= n; ++k)
 			{
-				fourthEdge = e;
-				break;
+				if (forward)
+					mesh->addQuad({ pointA(k), pointA(k + 1), pointB(k + 1), pointB(k) },
+						{ segmentA(k), rungs[k + 1], segmentB(k), rungs[k] });
+				else
+					mesh->addQuad({ pointA(k), pointB(k), pointB(k + 1), pointA(k + 1) },
+						{ rungs[k], segmentB(k), rungs[k + 1], segmentA(k) });
 			}
 		}
 
-		if (fourthEdge) 
-		{
-			fourthEdge->setColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)); // Green for debug
-			fourthEdge->hasbeenMarkedOnceInCutQuad = true;
-			QuadEdges.push_back(fourthEdge);
-		}
-		else
-		{
-			return;
-		}
-
-		// -------- Create the quad from the found edges
-		buildQuadFromEdges(QuadEdges, currentVert, nextVert, mesh);
+		// ---- retire the crossed quads and the ring edges they were cut along ---- //
+		auto& meshFaces = mesh->getFacesNonConst();
+		meshFaces.erase(std::remove_if(meshFaces.begin(), meshFaces.end(),
+			[&](Face* f) { return crossed.count(f) != 0; }), meshFaces.end());
 
-	}
-
-	void buildQuadFromEdges(const std::vector<Edge*>& QuadEdges, Vertice* currentVert, Vertice* nextVert, Mesh* mesh)
-	{
-		if (QuadEdges.empty())
+		for (const Crossing& c : crossings)
 		{
-			return;
+			c.quad->unlinkAdjacency();
+			c.quad->destroy();
+			mesh->freeFace(c.quad);
 		}
 
-		if (QuadEdges.size() != 4) 
+		for (Edge* edge : ringEdges)
 		{
-			return;
+			edge->getStart()->removeEdge(edge);
+			edge->getEnd()->removeEdge(edge);
+			mesh->detachEdge(edge);
+			edge->destroy();
+			mesh->freeEdge(edge);
 		}
 
-		if (!currentVert || !nextVert || !mesh)
-		{
-			return;
-		}
+		// render buffers, adjacency caches and the MeshDNA counts catch up once here
+		mesh->commitEdit("cut_quad");
 
-		std::array<Edge*, 4> quadEdges;
-		std::array<Vertice*, 4> quadVertices;
-		
-		// for now, i decided to assume arbitrarily the order of the edges in QuadEdges
-		Edge* perpEdge1 = QuadEdges[0];
-		Edge* centerEdge = QuadEdges[1];
-		Edge* perpEdge2 = QuadEdges[2];
-		Edge* parallelEdge = QuadEdges[3];
-		
-		Vertice* v0 = currentVert;
-		Vertice* v3 = nextVert;
-		
-		Vertice* v1 = (perpEdge1->getStart() == v0) ? perpEdge1->getEnd() : perpEdge1->getStart();
-		Vertice* v2 = (perpEdge2->getStart() == v3) ? perpEdge2->getEnd() : perpEdge2->getStart();
-		
-		quadVertices[0] = v0;
-		quadVertices[1] = v1;
-		quadVertices[2] = v2;
-		quadVertices[3] = v3;
-		
-		quadEdges[0] = perpEdge1;
-		quadEdges[1] = parallelEdge;
-		quadEdges[2] = perpEdge2; 
-		quadEdges[3] = centerEdge;
-		
-		Quad* newQuad = mesh->addQuad(quadVertices, quadEdges);
-		
-		if (newQuad)
-		{
-			newQuad->initialize();
-			
-			for (int k = 0; k < 4; ++k) 
-			{
-				auto& sharedFaces = quadEdges[k]->getSharedFacesNonConst();
-				sharedFaces.push_back(newQuad);
-			}
-			
-			newQuad->setParentMesh(mesh);							
-		}
-		else
-		{
-		}
+		std::cout << "[CutQuad] " << n << " loop(s) inserted across " << crossings.size() << " quads" << std::endl;
 	}
-
-
-}
\ No newline at end of file
+}
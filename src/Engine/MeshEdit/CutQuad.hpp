@@ -1,22 +1,16 @@
 #pragma once
 
 #include <vector>
-#include <unordered_set>
-#include <string>
+#include <cstdint>
 #include "WorldObjects/Basic/Edge.hpp"
 #include "WorldObjects/Mesh/Mesh.hpp"
 #include "WorldObjects/Basic/Quad.hpp"
 
 namespace MeshEdit 
 {
-	void CutQuad(const std::vector<Edge*>& loop, Mesh* mesh, const std::vector<Quad*>& traversedQuads);
-
-	void findFirstQuadEdgesWithVertice(const std::vector<class Vertice*>& centers, const std::unordered_set<std::string>& centerEdgeIDs, 
-	 const std::vector<Edge*>& centerEdges, Mesh* mesh, std::vector<Edge*>& firstRowEdges, std::vector<Edge*>& firstQuadEdges);
-
-	void findNextQuadEdgesForFirstRow(const std::vector<class Vertice*>& centers, const std::unordered_set<std::string>& centerEdgeIDs, 
-	const std::vector<Edge*>& centerEdges, Mesh* mesh, std::vector<Edge*>& QuadEdges, const glm::vec3& refDir, int currentIndex);
-
-	void buildQuadFromEdges(const std::vector<Edge*>& QuadEdges, class Vertice* currentVert, class Vertice* nextVert, Mesh* mesh);
-	
+	// Inserts `cuts` evenly spaced loops across the quads of an edge ring in one
+	// topology pass : every ring edge is split into cuts + 1 segments and every
+	// traversed quad is replaced by a strip of cuts + 1 quads. Rings whose edges
+	// also border faces outside the ring are left untouched.
+	void CutQuad(const std::vector<Edge*>& loop, Mesh* mesh, const std::vector<Quad*>& traversedQuads, int cuts = 1);
 }
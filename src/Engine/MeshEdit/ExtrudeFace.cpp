@@ -1,271 +1,300 @@
 #include "Engine/MeshEdit/ExtrudeFace.hpp"
 #include "WorldObjects/Mesh/Mesh.hpp"
-#include "WorldObjects/Entities/ThreedObject.hpp"
 #include "WorldObjects/Basic/Vertice.hpp"
 #include "WorldObjects/Basic/Edge.hpp"
 #include "WorldObjects/Basic/Face.hpp"
 #include "WorldObjects/Basic/Quad.hpp"
 
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
-
-#include <type_traits>
-#include <utility>
-#include <engine/ErrorBox.hpp>
+#include <cmath>
+#include <string>
+#include <iostream>
 
 namespace MeshEdit
 {
-	template<typename T, typename = void>
-	struct has_destroy : std::false_type {};
+	namespace
+	{
+		// Newell's method, so n-gons that are not quite planar still get a stable normal
+		glm::vec3 computeFaceNormalLocal(const Face* f)
+		{
+			const auto& vs = f->getVertices();
+			glm::vec3 n(0.0f);
+			for (size_t i = 0; i < vs.size(); ++i)
+			{
+				const glm::vec3 a = vs[i]->getLocalPosition();
+				const glm::vec3 b = vs[(i + 1) % vs.size()]->getLocalPosition();
+				n += glm::vec3((a.y - b.y) * (a.z + b.z), (a.z - b.z) * (a.x + b.x), (a.x - b.x) * (a.y + b.y));
+			}
 
-	template<typename T>
-	struct has_destroy<T, std::void_t<decltype(std::declval<T*>()->destroy())>> : std::true_type {};
+			const float len2 = glm::dot(n, n);
+			if (len2 < 1e-12f) {
+				return glm::vec3(0, 0, 1);
+			}
+			return n / std::sqrt(len2);
+		}
 
-	glm::vec3 computeFaceNormalLocal(const Face* f) 
-	{
-		const auto& vs = f->getVertices();
-		const glm::vec3 p0 = vs[0]->getLocalPosition();
-		const glm::vec3 p1 = vs[1]->getLocalPosition();
-		const glm::vec3 p2 = vs[2]->getLocalPosition();
-
-		const glm::vec3 u = p1 - p0;
-		const glm::vec3 v = p2 - p0;
-
-		glm::vec3 n = glm::cross(u, v);
-		const float len2 = glm::dot(n, n);
-		if (len2 < 1e-12f) {
-			return glm::vec3(0, 0, 1);
+		// edge registered on both its vertices, like the rest of the mesh expects
+		Edge* addLinkedEdge(Mesh* mesh, Vertice* a, Vertice* b)
+		{
+			Edge* e = mesh->addEdge(a, b);
+			a->addEdge(e);
+			b->addEdge(e);
+			return e;
 		}
-		return n / std::sqrt(len2);
-	}
 
-	Edge* findOrMakeEdge(std::vector<Edge*>& edges, Vertice* a, Vertice* b) 
-	{
-		for (Edge* e : edges) {
-			if ((e->getStart() == a && e->getEnd() == b) || (e->getStart() == b && e->getEnd() == a)) {
-				return e;
+		// side of f joining a and b, looked up in the mesh for faces built without edges
+		Edge* sideOf(Mesh* mesh, const Face* f, const Vertice* a, const Vertice* b)
+		{
+			for (Edge* e : f->getEdges())
+			{
+				if (e && ((e->getStart() == a && e->getEnd() == b) || (e->getStart() == b && e->getEnd() == a)))
+					return e;
 			}
+			return mesh->findEdge(a, b);
 		}
-		Edge* e = new Edge(a, b);
-		e->initialize();
-		edges.push_back(e);
-		return e;
-	}
 
-	Quad* makeQuad(Vertice* v0, Vertice* v1, Vertice* v2, Vertice* v3,
-	Edge* e0, Edge* e1, Edge* e2, Edge* e3) 
-	{
-		std::array<Vertice*, 4> quadVerts = {v0, v1, v2, v3};
-		std::array<Edge*, 4> quadEdges = {e0, e1, e2, e3};
-		Quad* q = new Quad(quadVerts, quadEdges);
-		q->initialize();
-		return q;
-	}
+		Face* addCap(Mesh* mesh, const std::vector<Vertice*>& vs, const std::vector<Edge*>& es)
+		{
+			if (vs.size() == 4)
+				return mesh->addQuad({ vs[0], vs[1], vs[2], vs[3] }, { es[0], es[1], es[2], es[3] });
+			if (vs.size() == 3)
+				return mesh->addTriangle(vs[0], vs[1], vs[2], es[0], es[1], es[2]);
+			return mesh->addNgon(vs, es);
+		}
 
-	void syncWorldFromLocal(Vertice* v, const glm::mat4& parentModel) 
-	{
-		const glm::vec4 wp = parentModel * glm::vec4(v->getLocalPosition(), 1.0f);
-		v->setPosition(glm::vec3(wp));
+		// one side of a region face, a to b in the face's winding
+		struct Side
+		{
+			uint32_t a = 0;
+			uint32_t b = 0;
+			Edge* edge = nullptr;
+			bool boundary = false;
+		};
 	}
 
-
-	bool extrudeQuadFace(
-		ThreeDObject* owner, std::vector<Vertice*>& vertices,
-		std::vector<Edge*>& edges, std::vector<Face*>& faces,
-		Face* target, float distance, ExtrudeResult* out
-	) 
+	bool extrudeRegion(Mesh* mesh, const std::vector<Face*>& region, float distance, ExtrudeResult* out)
 	{
-		if (!owner || !target) return false;
-
-		const auto& rVs = target->getVertices();
-		const auto& rEs = target->getEdges();
-		if (rVs.size() != 4 || rEs.size() != 4) return false;
+		if (!mesh || region.empty()) return false;
 
-		Vertice* oldV[4] = {rVs[0], rVs[1], rVs[2], rVs[3]};
-		Edge* oldE[4] = {rEs[0], rEs[1], rEs[2], rEs[3]};
-
-		glm::vec3 nLocal = computeFaceNormalLocal(target);
-
-		Mesh* mesh = dynamic_cast<Mesh*>(owner);
-		glm::vec3 meshCenter(0.0f);
-		if (mesh) {
-			const auto& meshVerts = mesh->getVertices();
-			for (auto* v : meshVerts) meshCenter += v->getLocalPosition();
-			if (!meshVerts.empty()) meshCenter /= float(meshVerts.size());
+		// ---- region faces, each once ---- //
+		std::vector<Face*> faces;
+		std::unordered_set<const Face*> inRegion;
+		faces.reserve(region.size());
+		inRegion.reserve(region.size());
+		for (Face* f : region)
+		{
+			if (!f || f->getVertices().size() < 3) continue;
+			if (inRegion.insert(f).second)
+				faces.push_back(f);
 		}
-		glm::vec3 faceCenter(0.0f);
-		for (int i=0;i<4;++i) faceCenter += rVs[i]->getLocalPosition();
-		faceCenter /= 4.0f;
-		glm::vec3 toCenter = glm::normalize(meshCenter - faceCenter);
-
-		if (glm::dot(nLocal, toCenter) > 0.0f) nLocal = -nLocal;
-		const glm::vec3 offset = nLocal * distance;
+		if (faces.empty()) return false;
 
-		Vertice* nv[4] = {nullptr,nullptr,nullptr,nullptr};
-		MeshDNA* dna = mesh ? mesh->getMeshDNA() : nullptr;
+		// ---- region vertices and the summed normals of the faces around them ---- //
+		std::vector<Vertice*> verts;
+		std::vector<glm::vec3> normals;
+		std::unordered_map<const Vertice*, uint32_t> slotOf;
+		slotOf.reserve(faces.size() * 2);
 
-		for (int i=0;i<4;++i) 
+		std::vector<Side> sides;
+		std::vector<uint32_t> corners;
+		glm::vec3 regionNormal(0.0f);
+		glm::vec3 regionCenter(0.0f);
+		for (Face* f : faces)
 		{
-			Vertice* src = oldV[i];
-			auto* v = new Vertice();
-			v->initialize();
-			v->setMeshParent(owner);
-			v->setLocalPosition(src->getLocalPosition() + offset);
-			syncWorldFromLocal(v, owner->getModelMatrix());
-			v->setName(src->getName() + "_extruded");
-			v->setColor(src->getColor());
-			vertices.push_back(v);
-			nv[i] = v;
-		   dna->setVerticeCount(dna->getVerticeCount() + 1);
-		}
+			const glm::vec3 n = computeFaceNormalLocal(f);
+			regionNormal += n;
 
-		Edge* capE[4] = {
-			findOrMakeEdge(edges, nv[0], nv[1]),
-			findOrMakeEdge(edges, nv[1], nv[2]),
-			findOrMakeEdge(edges, nv[2], nv[3]),
-			findOrMakeEdge(edges, nv[3], nv[0]),
-		};
-		for (int i=0;i<4;++i) {
-			// Associer les nouveaux edges aux vertices
-			if (capE[i]) {
-				nv[i]->addEdge(capE[i]);
-				nv[(i+1)%4]->addEdge(capE[i]);
+			corners.clear();
+			for (Vertice* v : f->getVertices())
+			{
+				auto slot = slotOf.emplace(v, static_cast<uint32_t>(verts.size()));
+				if (slot.second)
+				{
+					verts.push_back(v);
+					normals.push_back(glm::vec3(0.0f));
+					regionCenter += v->getLocalPosition();
+				}
+				normals[slot.first->second] += n;
+				corners.push_back(slot.first->second);
 			}
-			if (dna) dna->setEdgeCount(dna->getEdgeCount() + 1);
-		}
 
-		Edge* upE[4] = {
-			findOrMakeEdge(edges, oldV[0], nv[0]),
-			findOrMakeEdge(edges, oldV[1], nv[1]),
-			findOrMakeEdge(edges, oldV[2], nv[2]),
-			findOrMakeEdge(edges, oldV[3], nv[3]),
-		};
-		for (int i=0;i<4;++i) {
-			// Associer les edges verticaux aux vertices
-			if (upE[i]) {
-				oldV[i]->addEdge(upE[i]);
-				nv[i]->addEdge(upE[i]);
+			for (size_t i = 0; i < corners.size(); ++i)
+			{
+				Side s;
+				s.a = corners[i];
+				s.b = corners[(i + 1) % corners.size()];
+				s.edge = sideOf(mesh, f, verts[s.a], verts[s.b]);
+				sides.push_back(s);
 			}
-			if (dna) dna->setEdgeCount(dna->getEdgeCount() + 1);
 		}
+		regionCenter /= static_cast<float>(verts.size());
 
-		Quad* sideF[4] = {nullptr,nullptr,nullptr,nullptr};
-		for (int i=0;i<4;++i) 
+		// ---- boundary : sides whose edge no other region face shares ---- //
+		std::vector<char> onBoundary(verts.size(), 0);
+		size_t boundarySides = 0;
+		for (Side& s : sides)
 		{
-			const int i1 = (i+1)&3;
-			sideF[i] = makeQuad(
-				oldV[i], oldV[i1], nv[i1], nv[i],
-				findOrMakeEdge(edges, oldV[i], oldV[i1]),
-				findOrMakeEdge(edges, oldV[i1], nv[i1]),
-				findOrMakeEdge(edges, nv[i1], nv[i]),
-				findOrMakeEdge(edges, nv[i], oldV[i])
-			);
-			if (mesh) {
-				sideF[i]->setParentMesh(mesh);
+			int shared = 0;
+			if (s.edge)
+			{
+				for (const Face* other : s.edge->getSharedFaces())
+					shared += inRegion.count(other) != 0;
 			}
-			faces.push_back(sideF[i]);
-			dna->setQuadCount(dna->getQuadCount() + 1);
+			s.boundary = shared < 2;
+			if (!s.boundary) continue;
+
+			onBoundary[s.a] = 1;
+			onBoundary[s.b] = 1;
+			++boundarySides;
 		}
 
-		Quad* cap = makeQuad(nv[0], nv[1], nv[2], nv[3], capE[0], capE[1], capE[2], capE[3]);
-		if (mesh) {
-			cap->setParentMesh(mesh);
+		// extrude away from the mesh centre, as a single face always did
+		const glm::vec3 toCenter = mesh->getTopology().centroid() - regionCenter;
+		const float outward = glm::dot(regionNormal, toCenter) > 0.0f ? -1.0f : 1.0f;
+
+		const size_t boundaryVerts = static_cast<size_t>(std::count(onBoundary.begin(), onBoundary.end(), 1));
+
+		ExtrudeResult res;
+		res.newVerts.reserve(boundaryVerts);
+		res.upEdges.reserve(boundaryVerts);
+		res.sideFaces.reserve(boundarySides);
+		res.capFaces.reserve(faces.size());
+		res.oldVerts.reserve(sides.size());
+		res.oldEdges.reserve(sides.size());
+		res.oldSides.reserve(faces.size());
+		for (Face* f : faces)
+			res.oldSides.push_back(static_cast<uint32_t>(f->getVertices().size()));
+		for (const Side& s : sides)
+		{
+			res.oldVerts.push_back(verts[s.a]);
+			res.oldEdges.push_back(s.edge);
 		}
-		faces.push_back(cap);
-		dna->setQuadCount(dna->getQuadCount() + 1);
 
-		auto it = std::find(faces.begin(), faces.end(), target);
-		if (it != faces.end()) 
+		mesh->beginEdit();
+		mesh->reserve(boundaryVerts, boundaryVerts + sides.size(), faces.size() + boundarySides);
+
+		// ---- boundary vertices split, the others move ---- //
+		std::vector<Vertice*> mapped(verts.size());
+		std::vector<Edge*> upOf(verts.size(), nullptr);
+		for (size_t i = 0; i < verts.size(); ++i)
 		{
-			Face* toDelete = *it;
-			faces.erase(it);
-			if constexpr (has_destroy<Face>::value) 
+			Vertice* src = verts[i];
+			const float len2 = glm::dot(normals[i], normals[i]);
+			const glm::vec3 dir = len2 < 1e-12f ? glm::vec3(0, 0, 1) : normals[i] / std::sqrt(len2);
+			const glm::vec3 offset = dir * (outward * distance);
+
+			if (!onBoundary[i])
 			{
-				toDelete->destroy();
+				src->setLocalPosition(src->getLocalPosition() + offset);
+				mapped[i] = src;
+				res.movedVerts.push_back(src);
+				res.movedBy.push_back(offset);
+				continue;
 			}
-			delete toDelete;
-			dna->setQuadCount(dna->getQuadCount() - 1);
-		}
 
-		std::vector<Face*> allFaces;
-		allFaces.reserve(faces.size());
-		for (Face* f : faces) {
-			if (f) allFaces.push_back(f);
+			const std::string& name = src->getName();
+			Vertice* v = mesh->addVertice(src->getLocalPosition() + offset, name.empty() ? name : name + "_extruded");
+			v->setColor(src->getColor());
+			mapped[i] = v;
+			upOf[i] = addLinkedEdge(mesh, src, v);
+			res.newVerts.push_back(v);
+			res.upEdges.push_back(upOf[i]);
 		}
 
-		for (Edge* edge : edges)
+		// ---- caps : the region faces over the moved and split vertices ---- //
+		std::vector<Vertice*> capVerts;
+		std::vector<Edge*> capSides;
+		size_t at = 0;
+		for (Face* f : faces)
 		{
-			if (!edge) continue;
-			std::vector<Face*> sharedFaces;
-			
-			Vertice* vertA = edge->getStart();
-			Vertice* vertB = edge->getEnd();
-			if (!vertA || !vertB) continue;
-			
-			for (Face* face : allFaces)
+			const size_t n = f->getVertices().size();
+			capVerts.clear();
+			capSides.clear();
+			for (size_t i = 0; i < n; ++i)
+				capVerts.push_back(mapped[sides[at + i].a]);
+
+			for (size_t i = 0; i < n; ++i)
 			{
-				if (!face) continue;
-				const auto& faceEdges = face->getEdges();
-				
-				bool hasEdge = false;
-				for (Edge* faceEdge : faceEdges)
-				{
-					if (faceEdge == edge)
-					{
-						hasEdge = true;
-						break;
-					}
-				}
-				
-				if (hasEdge)
+				const Side& s = sides[at + i];
+				Vertice* a = mapped[s.a];
+				Vertice* b = mapped[s.b];
+
+				// an edge between two moved vertices moved along with them
+				Edge* e = s.edge;
+				if (a != verts[s.a] || b != verts[s.b])
 				{
-					bool alreadyAdded = false;
-					for (Face* existingFace : sharedFaces)
-					{
-						if (existingFace == face)
-						{
-							alreadyAdded = true;
-							break;
-						}
-					}
-					
-					if (!alreadyAdded)
+					e = mesh->findEdge(a, b);
+					if (!e)
 					{
-						sharedFaces.push_back(face);
-						
-						if (sharedFaces.size() > 2)
-						{
-							std::cout << "[ExtrudeFace] WARNING: Edge has more than 2 shared faces! This violates manifold topology." << std::endl;
-							sharedFaces.resize(2);
-							break;
-						}
+						e = addLinkedEdge(mesh, a, b);
+						res.capEdges.push_back(e);
 					}
 				}
+				capSides.push_back(e);
 			}
-			
-			edge->setSharedFaces(sharedFaces);
+
+			res.capFaces.push_back(addCap(mesh, capVerts, capSides));
+			at += n;
 		}
 
-		if (out) 
+		// ---- side walls, one quad per boundary side ---- //
+		for (const Side& s : sides)
 		{
-			out->ok = true;
-			for (int i=0;i<4;++i) 
-			{
-				out->newVerts[i] = nv[i];
-				out->capEdges[i] = capE[i];
-				out->upEdges[i] = upE[i];
-				out->sideFaces[i] = sideF[i];
-				out->oldVerts[i] = oldV[i];
-				out->oldEdges[i] = oldE[i];
-			}
-			out->capFace  = cap;
-			out->distance = distance;
-		}   
+			if (!s.boundary) continue;
+			Vertice* a = verts[s.a];
+			Vertice* b = verts[s.b];
+			Vertice* topA = mapped[s.a];
+			Vertice* topB = mapped[s.b];
+			res.sideFaces.push_back(mesh->addQuad({ a, b, topB, topA },
+				{ s.edge, upOf[s.b], mesh->findEdge(topB, topA), upOf[s.a] }));
+		}
 
-		return true;
-	}
+		// ---- the region faces give way to their caps ---- //
+		auto& meshFaces = mesh->getFacesNonConst();
+		meshFaces.erase(std::remove_if(meshFaces.begin(), meshFaces.end(),
+			[&](Face* f) { return inRegion.count(f) != 0; }), meshFaces.end());
 
+		for (Face* f : faces)
+		{
+			f->unlinkAdjacency();
+			f->destroy();
+			mesh->freeFace(f);
+		}
 
+		// inner edges that reached a split vertex now belong to no face
+		std::vector<Edge*> retired;
+		for (size_t i = 0; i < sides.size(); ++i)
+		{
+			const Side& s = sides[i];
+			if (s.boundary || !s.edge || !s.edge->getSharedFaces().empty()) continue;
+			if (mapped[s.a] == verts[s.a] && mapped[s.b] == verts[s.b]) continue;
 
-} 
\ No newline at end of file
+			res.oldEdges[i] = nullptr;
+			retired.push_back(s.edge);
+		}
+
+		// both region faces on an inner edge listed it
+		std::sort(retired.begin(), retired.end());
+		retired.erase(std::unique(retired.begin(), retired.end()), retired.end());
+		for (Edge* e : retired)
+		{
+			e->getStart()->removeEdge(e);
+			e->getEnd()->removeEdge(e);
+			mesh->detachEdge(e);
+			e->destroy();
+			mesh->freeEdge(e);
+		}
+
+		// the caller records the extrusion itself, so no topology event here
+		mesh->commitEdit({});
+
+		res.ok = true;
+		res.distance = distance;
+		if (out) *out = std::move(res);
+
+		std::cout << "[Extrude] " << faces.size() << " face(s), " << boundarySides << " side wall(s)" << std::endl;
+		return true;
+	}
+}
@@ -1,37 +1,39 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 
-class ThreeDObject;
+class Mesh;
 class Vertice;
 class Edge;
 class Face;
 
 namespace MeshEdit {
 
+// What one region extrusion created, moved and replaced. Vertices on the
+// region's boundary are split : the originals stay at the base, the copies
+// ride the caps. Vertices inside the region move in place.
 struct ExtrudeResult {
     bool ok{false};
-    Vertice* newVerts[4]{nullptr,nullptr,nullptr,nullptr};
-    Edge*    capEdges[4]{nullptr,nullptr,nullptr,nullptr};
-    Edge*    upEdges[4]{nullptr,nullptr,nullptr,nullptr};
-    Face*    sideFaces[4]{nullptr,nullptr,nullptr,nullptr};
-    Face*    capFace{nullptr};
-
-    Vertice* oldVerts[4]{nullptr,nullptr,nullptr,nullptr};
-    Edge*    oldEdges[4]{nullptr,nullptr,nullptr,nullptr};
-    float    distance{0.f};
+    std::vector<Vertice*> newVerts;   // one copy per boundary vertex
+    std::vector<Edge*>    upEdges;    // base vertex to its copy, same order as newVerts
+    std::vector<Edge*>    capEdges;   // cap edges created for the copies
+    std::vector<Face*>    sideFaces;  // one quad per boundary side
+    std::vector<Face*>    capFaces;   // one per region face, in region order
+
+    std::vector<Vertice*>  movedVerts;
+    std::vector<glm::vec3> movedBy;
+
+    // the region faces, flattened : face i held oldSides[i] vertices and edges.
+    // Edges retired by the extrusion are left null.
+    std::vector<Vertice*> oldVerts;
+    std::vector<Edge*>    oldEdges;
+    std::vector<uint32_t> oldSides;
+    float distance{0.f};
 };
 
+// Extrudes a set of faces as one region along the averaged normals of its
+// vertices, only the boundary gets side walls.
+bool extrudeRegion(Mesh* mesh, const std::vector<Face*>& region, float distance, ExtrudeResult* out);
 
-
-bool extrudeQuadFace(
-    ThreeDObject* owner,
-    std::vector<Vertice*>& vertices,
-    std::vector<Edge*>& edges,
-    std::vector<Face*>& faces,
-    Face* target,
-    float distance,
-    ExtrudeResult* out
-);
-
-} 
+}
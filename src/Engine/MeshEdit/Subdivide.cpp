@@ -0,0 +1,99 @@
+#include "Engine/MeshEdit/Subdivide.hpp"
+#include "WorldObjects/Mesh/MeshSubdivision.hpp"
+#include "WorldObjects/Mesh/MeshTopology.hpp"
+#include "WorldObjects/Basic/Vertice.hpp"
+#include "WorldObjects/Basic/Edge.hpp"
+#include "WorldObjects/Basic/Quad.hpp"
+#include <iostream>
+#include <algorithm>
+
+namespace MeshEdit
+{
+	void Subdivide(Mesh* mesh, int levels, unsigned threads)
+	{
+		if (!mesh || levels < 1) return;
+
+		const MeshTopology& topo = mesh->getTopology();
+		if (topo.faceCount() == 0) return;
+
+		const MeshSubdivision::Cage cage = MeshSubdivision::subdivide(topo, levels, threads);
+
+		mesh->beginEdit();
+		// the edges are reserved by addEdges, after the old ones leave the index
+		mesh->reserve(cage.vertexCount() - topo.vertexCount(), 0, cage.faceCount());
+
+		// ---- the old cage goes : every face of the topology and every edge a face ran along ---- //
+		auto& meshFaces = mesh->getFacesNonConst();
+		meshFaces.erase(std::remove_if(meshFaces.begin(), meshFaces.end(),
+			[&](Face* f) { return topo.handleOf(f) != MeshTopology::kInvalid; }), meshFaces.end());
+
+		for (uint32_t f = 0; f < topo.faceCount(); ++f)
+		{
+			Face* face = topo.face(f);
+			face->unlinkAdjacency();
+			face->destroy();
+			mesh->freeFace(face);
+		}
+
+		for (uint32_t e = 0; e < topo.edgeCount(); ++e)
+		{
+			if (topo.edgeHalfEdge(e) == MeshTopology::kInvalid) continue;
+			Edge* edge = topo.edge(e);
+			edge->getStart()->removeEdge(edge);
+			edge->getEnd()->removeEdge(edge);
+			mesh->detachEdge(edge);
+			edge->destroy();
+			mesh->freeEdge(edge);
+		}
+
+		// ---- cage vertex v is still topology vertex v, the rest are new ---- //
+		std::vector<Vertice*> verts(cage.vertexCount());
+		for (uint32_t v = 0; v < topo.vertexCount(); ++v)
+		{
+			verts[v] = topo.vertice(v);
+			verts[v]->setLocalPosition(cage.points[v]);
+		}
+		for (size_t v = topo.vertexCount(); v < cage.vertexCount(); ++v)
+			verts[v] = mesh->addVertice(cage.points[v]);
+
+		// ---- elements first, adjacency in one pass after, each list sized once ---- //
+		std::vector<Vertice*> ends(cage.edgeVerts.size());
+		for (size_t i = 0; i < ends.size(); ++i)
+			ends[i] = verts[cage.edgeVerts[i]];
+		std::vector<Edge*> edges;
+		mesh->addEdges(ends, edges);
+
+		auto& refinedFaces = mesh->getFacesNonConst();
+		const size_t firstFace = refinedFaces.size();
+		for (size_t f = 0; f < cage.faceCount(); ++f)
+		{
+			const uint32_t* c = &cage.corners[cage.faceStart[f]];
+			const uint32_t* s = &cage.cornerEdge[cage.faceStart[f]];
+			Quad* quad = mesh->createQuad({ verts[c[0]], verts[c[1]], verts[c[2]], verts[c[3]] },
+				{ edges[s[0]], edges[s[1]], edges[s[2]], edges[s[3]] });
+			quad->setParentMesh(mesh);
+			refinedFaces.push_back(quad);
+		}
+
+		// a vertex has one edge per edge end on it and one face per corner
+		std::vector<uint32_t> edgeEnds(cage.vertexCount(), 0);
+		std::vector<uint32_t> cornersOn(cage.vertexCount(), 0);
+		for (uint32_t v : cage.edgeVerts) ++edgeEnds[v];
+		for (uint32_t v : cage.corners) ++cornersOn[v];
+		for (size_t v = 0; v < cage.vertexCount(); ++v)
+			verts[v]->reserveAdjacency(edgeEnds[v], cornersOn[v]);
+
+		for (size_t e = 0; e < cage.edgeCount(); ++e)
+		{
+			verts[cage.edgeVerts[2 * e]]->addEdge(edges[e]);
+			verts[cage.edgeVerts[2 * e + 1]]->addEdge(edges[e]);
+			edges[e]->getSharedFacesNonConst().reserve(cage.edgeFaces[2 * e + 1] == MeshSubdivision::kInvalid ? 1 : 2);
+		}
+		for (size_t f = firstFace; f < refinedFaces.size(); ++f)
+			refinedFaces[f]->linkAdjacency();
+
+		mesh->commitEdit("subdivide");
+
+		std::cout << "[Subdivide] " << levels << " level(s), " << cage.faceCount() << " quads" << std::endl;
+	}
+}
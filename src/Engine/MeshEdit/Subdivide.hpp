@@ -0,0 +1,12 @@
+#pragma once
+
+#include "WorldObjects/Mesh/Mesh.hpp"
+
+namespace MeshEdit 
+{
+	// Replaces the faces of the mesh with `levels` steps of Catmull-Clark
+	// subdivision, computed by MeshSubdivision across `threads` workers
+	// (0 : every hardware thread). Existing vertices are kept and moved to
+	// their vertex points; edges and faces are rebuilt in one transaction.
+	void Subdivide(Mesh* mesh, int levels = 1, unsigned threads = 0);
+}
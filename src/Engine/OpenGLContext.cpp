@@ -22,6 +22,13 @@ void OpenGLContext::initialize()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fboTexture, 0);
 
+    if (!pickTexture) glGenTextures(1, &pickTexture);
+    glBindTexture(GL_TEXTURE_2D, pickTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32UI, width, height, 0, GL_RG_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, pickTexture, 0);
+
     if (!rbo) glGenRenderbuffers(1, &rbo);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
@@ -46,6 +53,9 @@ void OpenGLContext::resize(int w, int h)
     glBindTexture(GL_TEXTURE_2D, fboTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 
+    glBindTexture(GL_TEXTURE_2D, pickTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32UI, width, height, 0, GL_RG_INTEGER, GL_UNSIGNED_INT, nullptr);
+
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
 }
@@ -53,7 +63,42 @@ void OpenGLContext::resize(int w, int h)
 void OpenGLContext::bindForRendering()
 {
     glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    const GLenum colorOnly[] = { GL_COLOR_ATTACHMENT0 };
+    glDrawBuffers(1, colorOnly);
+    glViewport(0, 0, width, height);
+}
+
+void OpenGLContext::bindForPicking()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    const GLenum pickOnly[] = { GL_NONE, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, pickOnly);
     glViewport(0, 0, width, height);
+
+    const GLuint noId[] = { 0, 0, 0, 0 };
+    glClearBufferuiv(GL_COLOR, 1, noId);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+bool OpenGLContext::readPickRect(int x, int y, int radius, std::vector<glm::uvec2>& outIds, glm::ivec4& outRect) const
+{
+    const int x0 = std::max(0, x - radius);
+    const int y0 = std::max(0, y - radius);
+    const int x1 = std::min(width - 1, x + radius);
+    const int y1 = std::min(height - 1, y + radius);
+    if (x0 > x1 || y0 > y1)
+        return false;
+
+    outRect = glm::ivec4(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+    outIds.assign(static_cast<size_t>(outRect.z) * outRect.w, glm::uvec2(0));
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(x0, y0, outRect.z, outRect.w, GL_RG_INTEGER, GL_UNSIGNED_INT, outIds.data());
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return true;
 }
 
 void OpenGLContext::unbind()
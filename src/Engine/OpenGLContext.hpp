@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include "WorldObjects/Camera/Camera.hpp"
 #include <iostream>
+#include <vector>
 
 class OpenGLContext
 {
@@ -16,16 +17,24 @@ public:
     void bindForRendering();
     void unbind();
 
+    // ---- picking ---- //
+    // element IDs are written to an RG32UI attachment : (object id, element index + 1)
+    void bindForPicking();
+    // reads the square around (x, y) clamped to the framebuffer; outRect = x0, y0, width, height
+    bool readPickRect(int x, int y, int radius, std::vector<glm::uvec2>& outIds, glm::ivec4& outRect) const;
+
 
     GLuint getFbo() const { return fbo; }
     GLuint getTexture() const { return fboTexture; }
+    GLuint getPickTexture() const { return pickTexture; }
     int getWidth()  const { return width; }
     int getHeight() const { return height; }
 
 private:
-    GLuint fbo;
-    GLuint fboTexture;
-    GLuint rbo;
+    GLuint fbo = 0;
+    GLuint fboTexture = 0;
+    GLuint pickTexture = 0;
+    GLuint rbo = 0;
 
     int width  = 800;
     int height = 600;
@@ -1,5 +1,6 @@
 #include "Engine/PrimitivesCreation/CreatePrimitive.hpp"
 #include <vector>
+#include <algorithm>
 #include <iostream>
 
 namespace Primitives
@@ -99,88 +100,7 @@ namespace Primitives
                 mesh->getMeshDNA()->setQuadCount(mesh->getMeshDNA()->getQuadCount() + 1);
         }
 
-        for (Edge* edge : es)
-        {
-            std::vector<Face*> sharedFaces;
-            
-            Vertice* vertA = edge->getStart();
-            Vertice* vertB = edge->getEnd();
-            
-            std::vector<Edge*> edgesFromA;
-            for (Edge* otherEdge : es)
-            {
-                if (otherEdge != edge && 
-                    (otherEdge->getStart() == vertA || otherEdge->getEnd() == vertA))
-                {
-                    edgesFromA.push_back(otherEdge);
-                }
-            }
-            
-            std::vector<Edge*> edgesFromB;
-            for (Edge* otherEdge : es)
-            {
-                if (otherEdge != edge && 
-                    (otherEdge->getStart() == vertB || otherEdge->getEnd() == vertB))
-                {
-                    edgesFromB.push_back(otherEdge);
-                }
-            }
-            
-            for (Edge* edgeA : edgesFromA)
-            {
-                Vertice* otherVertA = (edgeA->getStart() == vertA) ? edgeA->getEnd() : edgeA->getStart();
-                
-                for (Edge* edgeB : edgesFromB)
-                {
-                    Vertice* otherVertB = (edgeB->getStart() == vertB) ? edgeB->getEnd() : edgeB->getStart();
-                    
-
-                    for (Edge* connectingEdge : es)
-                    {
-                        if ((connectingEdge->getStart() == otherVertA && connectingEdge->getEnd() == otherVertB) ||
-                            (connectingEdge->getStart() == otherVertB && connectingEdge->getEnd() == otherVertA))
-                        {
-
-                            for (Quad* quad : quads)
-                            {
-                                const auto& quadEdges = quad->getEdgesArray();
-                                bool hasEdge = false, hasEdgeA = false, hasEdgeB = false, hasConnecting = false;
-                                
-                                for (const auto& qe : quadEdges)
-                                {
-                                    if (qe == edge) hasEdge = true;
-                                    if (qe == edgeA) hasEdgeA = true;
-                                    if (qe == edgeB) hasEdgeB = true;
-                                    if (qe == connectingEdge) hasConnecting = true;
-                                }
-                                
-                                if (hasEdge && hasEdgeA && hasEdgeB && hasConnecting)
-                                {
-                                    bool alreadyAdded = false;
-                                    for (Face* existingFace : sharedFaces)
-                                    {
-                                        if (existingFace == quad)
-                                        {
-                                            alreadyAdded = true;
-                                            break;
-                                        }
-                                    }
-                                    
-                                    if (!alreadyAdded)
-                                    {
-                                        sharedFaces.push_back(quad);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            
-            edge->setSharedFaces(sharedFaces);
-        
-        }
-
+        // addQuad already registered each quad on its edges and vertices
         mesh->finalize();
 
         return mesh;
@@ -0,0 +1,346 @@
+#include "Engine/SceneBVH.hpp"
+#include "WorldObjects/Entities/ThreeDObject.hpp"
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include <algorithm>
+#include <limits>
+
+// fat box margin, relative to the object's size plus a small absolute part
+static constexpr float kFatRatio = 0.1f;
+static constexpr float kFatMin = 0.05f;
+
+static float surfaceArea(const glm::vec3& bmin, const glm::vec3& bmax)
+{
+    const glm::vec3 d = bmax - bmin;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+static bool contains(const glm::vec3& outerMin, const glm::vec3& outerMax, const glm::vec3& innerMin, const glm::vec3& innerMax)
+{
+    return glm::all(glm::lessThanEqual(outerMin, innerMin)) && glm::all(glm::greaterThanEqual(outerMax, innerMax));
+}
+
+static bool rayHitsBox(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& bmin, const glm::vec3& bmax,
+    float maxT, float& outEntry)
+{
+    const glm::vec3 t0 = (bmin - origin) * invDir;
+    const glm::vec3 t1 = (bmax - origin) * invDir;
+    const glm::vec3 tNear = glm::min(t0, t1);
+    const glm::vec3 tFar = glm::max(t0, t1);
+
+    const float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+    outEntry = entry;
+    return entry <= exit;
+}
+
+void SceneBVH::computeWorldBounds(const ThreeDObject& object, glm::vec3& outMin, glm::vec3& outMax)
+{
+    // objects without geometry keep the unit box the selector always used
+    glm::vec3 localMin(-0.5f), localMax(0.5f);
+    object.getLocalBounds(localMin, localMax);
+
+    const glm::mat4 model = object.getModelMatrix();
+    const glm::vec3 center = glm::vec3(model * glm::vec4((localMin + localMax) * 0.5f, 1.0f));
+    const glm::vec3 half = (localMax - localMin) * 0.5f;
+
+    glm::vec3 extent(0.0f);
+    for (int axis = 0; axis < 3; ++axis)
+        extent += glm::abs(glm::vec3(model[axis])) * half[axis];
+
+    outMin = center - extent;
+    outMax = center + extent;
+}
+
+// ---- node pool ---- //
+
+int SceneBVH::allocateNode()
+{
+    if (freeList >= 0)
+    {
+        const int index = freeList;
+        freeList = nodes[index].parent;
+        nodes[index] = Node{};
+        return index;
+    }
+    nodes.emplace_back();
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void SceneBVH::freeNode(int index)
+{
+    nodes[index] = Node{};
+    nodes[index].parent = freeList;
+    freeList = index;
+}
+
+SceneBVH::~SceneBVH()
+{
+    clear();
+}
+
+void SceneBVH::clear()
+{
+    // the objects outlive the tree, they must stop reporting to it
+    for (Node& node : nodes)
+    {
+        if (node.object)
+        {
+            node.object->sceneBVH = nullptr;
+            node.object->bvhLeaf = -1;
+        }
+    }
+    nodes.clear();
+    dirtyLeaves.clear();
+    root = -1;
+    freeList = -1;
+    leafCount = 0;
+}
+
+// ---- tree edits ---- //
+
+void SceneBVH::insert(ThreeDObject* object)
+{
+    if (!object || owns(object))
+        return;
+    if (object->sceneBVH)
+        object->sceneBVH->remove(object);
+
+    const int leaf = allocateNode();
+    nodes[leaf].object = object;
+    object->sceneBVH = this;
+    object->bvhLeaf = leaf;
+    ++leafCount;
+
+    fitLeaf(leaf);
+    insertLeaf(leaf);
+}
+
+void SceneBVH::remove(ThreeDObject* object)
+{
+    if (!object || object->sceneBVH != this)
+        return;
+
+    const bool owned = owns(object);
+    const int leaf = object->bvhLeaf;
+    object->sceneBVH = nullptr;
+    object->bvhLeaf = -1;
+    if (!owned)
+        return;
+
+    removeLeaf(leaf);
+    freeNode(leaf);
+    --leafCount;
+}
+
+bool SceneBVH::owns(const ThreeDObject* object) const
+{
+    // a copied object carries the original's leaf without owning it
+    const int leaf = object->bvhLeaf;
+    return object->sceneBVH == this && leaf >= 0 && nodes[leaf].object == object;
+}
+
+void SceneBVH::fitLeaf(int leaf)
+{
+    glm::vec3 bmin, bmax;
+    computeWorldBounds(*nodes[leaf].object, bmin, bmax);
+    const glm::vec3 margin = (bmax - bmin) * kFatRatio + glm::vec3(kFatMin);
+    nodes[leaf].bmin = bmin - margin;
+    nodes[leaf].bmax = bmax + margin;
+}
+
+void SceneBVH::insertLeaf(int leaf)
+{
+    if (root < 0)
+    {
+        root = leaf;
+        nodes[leaf].parent = -1;
+        return;
+    }
+
+    const glm::vec3 leafMin = nodes[leaf].bmin;
+    const glm::vec3 leafMax = nodes[leaf].bmax;
+
+    // descend towards the child whose area grows the least
+    int index = root;
+    while (!nodes[index].isLeaf())
+    {
+        const Node& node = nodes[index];
+        const float area = surfaceArea(node.bmin, node.bmax);
+        const float combined = surfaceArea(glm::min(node.bmin, leafMin), glm::max(node.bmax, leafMax));
+
+        const float newParentCost = 2.0f * combined;
+        const float inheritance = 2.0f * (combined - area);
+
+        auto childCost = [&](int child)
+        {
+            const Node& c = nodes[child];
+            const float grown = surfaceArea(glm::min(c.bmin, leafMin), glm::max(c.bmax, leafMax));
+            return c.isLeaf() ? grown + inheritance : (grown - surfaceArea(c.bmin, c.bmax)) + inheritance;
+        };
+
+        const float costLeft = childCost(node.left);
+        const float costRight = childCost(node.right);
+        if (newParentCost < costLeft && newParentCost < costRight)
+            break;
+
+        index = costLeft < costRight ? node.left : node.right;
+    }
+
+    const int sibling = index;
+    const int oldParent = nodes[sibling].parent;
+    const int newParent = allocateNode();
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[newParent].bmin = glm::min(nodes[sibling].bmin, leafMin);
+    nodes[newParent].bmax = glm::max(nodes[sibling].bmax, leafMax);
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent < 0)
+        root = newParent;
+    else if (nodes[oldParent].left == sibling)
+        nodes[oldParent].left = newParent;
+    else
+        nodes[oldParent].right = newParent;
+
+    refitAncestors(oldParent);
+}
+
+void SceneBVH::removeLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = -1;
+        return;
+    }
+
+    const int parent = nodes[leaf].parent;
+    const int grandParent = nodes[parent].parent;
+    const int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grandParent < 0)
+    {
+        root = sibling;
+        nodes[sibling].parent = -1;
+    }
+    else
+    {
+        if (nodes[grandParent].left == parent)
+            nodes[grandParent].left = sibling;
+        else
+            nodes[grandParent].right = sibling;
+        nodes[sibling].parent = grandParent;
+        refitAncestors(grandParent);
+    }
+    freeNode(parent);
+}
+
+void SceneBVH::refitAncestors(int index)
+{
+    while (index >= 0)
+    {
+        Node& node = nodes[index];
+        node.bmin = glm::min(nodes[node.left].bmin, nodes[node.right].bmin);
+        node.bmax = glm::max(nodes[node.left].bmax, nodes[node.right].bmax);
+        index = node.parent;
+    }
+}
+
+// ---- update ---- //
+
+void SceneBVH::update()
+{
+    for (int leaf : dirtyLeaves)
+    {
+        // freed, or handed to another object that is fitted on insert
+        if (!nodes[leaf].dirty)
+            continue;
+        nodes[leaf].dirty = false;
+
+        glm::vec3 bmin, bmax;
+        computeWorldBounds(*nodes[leaf].object, bmin, bmax);
+        if (contains(nodes[leaf].bmin, nodes[leaf].bmax, bmin, bmax))
+            continue;
+
+        removeLeaf(leaf);
+        fitLeaf(leaf);
+        insertLeaf(leaf);
+    }
+    dirtyLeaves.clear();
+}
+
+// ---- query ---- //
+
+ThreeDObject* SceneBVH::raycast(const glm::vec3& rayOrigin, const glm::vec3& rayDir, float& outDistance) const
+{
+    if (root < 0)
+        return nullptr;
+
+    const glm::vec3 invDir = 1.0f / rayDir;
+    float best = std::numeric_limits<float>::max();
+    ThreeDObject* bestObject = nullptr;
+
+    std::vector<int> stack;
+    stack.push_back(root);
+
+    while (!stack.empty())
+    {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+
+        float entry;
+        if (!rayHitsBox(rayOrigin, invDir, node.bmin, node.bmax, best, entry))
+            continue;
+
+        if (!node.isLeaf())
+        {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+            continue;
+        }
+
+        ThreeDObject* obj = node.object;
+        if (!obj->isSelectable())
+            continue;
+
+        float distance = std::numeric_limits<float>::max();
+        if (obj->getIsMesh())
+        {
+            Mesh* mesh = static_cast<Mesh*>(obj);
+            if (!mesh->hasTopology())
+                continue;
+
+            if (mesh->faceCount() > 0)
+            {
+                // hit parameter is the world distance because rayDir is normalized
+                const glm::mat4 invModel = glm::inverse(mesh->getModelMatrix());
+                const glm::vec3 localOrigin = glm::vec3(invModel * glm::vec4(rayOrigin, 1.0f));
+                const glm::vec3 localDir = glm::vec3(invModel * glm::vec4(rayDir, 0.0f));
+
+                Face* face = nullptr;
+                if (!mesh->getBVH().raycastFaces(*mesh, localOrigin, localDir, distance, face))
+                    continue;
+            }
+        }
+
+        if (distance == std::numeric_limits<float>::max())
+        {
+            glm::vec3 bmin, bmax;
+            computeWorldBounds(*obj, bmin, bmax);
+            if (!rayHitsBox(rayOrigin, invDir, bmin, bmax, best, distance))
+                continue;
+        }
+
+        if (distance < best)
+        {
+            best = distance;
+            bestObject = obj;
+        }
+    }
+
+    if (bestObject)
+        outDistance = best;
+    return bestObject;
+}
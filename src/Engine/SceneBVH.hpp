@@ -0,0 +1,75 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+class ThreeDObject;
+
+// Dynamic AABB tree over the world-space bounds of scene objects, used for
+// object picking. Leaves keep a slightly enlarged ("fat") box so small
+// moves only refresh the leaf; an object is reinserted once it leaves it.
+// Each object knows its leaf, so adds, removals and moves cost O(log n).
+class SceneBVH
+{
+public:
+    SceneBVH() = default;
+    SceneBVH(const SceneBVH&) = delete;
+    SceneBVH& operator=(const SceneBVH&) = delete;
+    ~SceneBVH();
+
+    // scene membership; from insert on, the object reports its own bound
+    // changes through markDirty, so nothing walks the scene list per query
+    void insert(ThreeDObject* object);
+    void remove(ThreeDObject* object);
+
+    // called by ThreeDObject when its world bounds may have moved
+    void markDirty(int leaf)
+    {
+        if (nodes[leaf].dirty) return;
+        nodes[leaf].dirty = true;
+        dirtyLeaves.push_back(leaf);
+    }
+
+    // refits the leaves marked dirty since the last update, and only those
+    void update();
+
+    // nearest selectable object actually hit by the ray (rayDir normalized);
+    // meshes are tested against their faces, other objects against their box
+    ThreeDObject* raycast(const glm::vec3& rayOrigin, const glm::vec3& rayDir, float& outDistance) const;
+
+    size_t size() const { return leafCount; }
+    size_t dirtyCount() const { return dirtyLeaves.size(); }
+    void clear();
+
+    static void computeWorldBounds(const ThreeDObject& object, glm::vec3& outMin, glm::vec3& outMax);
+
+private:
+    struct Node
+    {
+        glm::vec3 bmin;
+        glm::vec3 bmax;
+        int parent = -1;
+        int left = -1;
+        int right = -1;
+        ThreeDObject* object = nullptr;
+        bool dirty = false;
+
+        bool isLeaf() const { return left < 0; }
+    };
+
+    int allocateNode();
+    void freeNode(int index);
+    bool owns(const ThreeDObject* object) const;
+    void fitLeaf(int leaf);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    void refitAncestors(int index);
+
+    std::vector<Node> nodes;
+    int root = -1;
+    int freeList = -1;
+    size_t leafCount = 0;
+
+    // may hold leaves removed since they were marked, update skips those
+    std::vector<int> dirtyLeaves;
+};
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+// Process-wide counter of edits that change what the 3D viewport shows :
+// transforms, geometry, colors and selection bump it. ThreeDScene::render
+// skips the redraw while it (and the camera) are unchanged.
+class SceneRevision
+{
+public:
+    static void bump() { ++counter; }
+    static uint64_t current() { return counter; }
+
+private:
+    static inline uint64_t counter = 1;
+};
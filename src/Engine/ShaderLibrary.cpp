@@ -0,0 +1,332 @@
+#include "Engine/ShaderLibrary.hpp"
+#include <glad/glad.h>
+#include <iostream>
+
+// ---- shared header ---- //
+// Prepended to every stage : version line and the per-frame camera block.
+
+static const char* shaderHeaderSrc = R"(#version 330 core
+layout(std140) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+};
+)";
+
+struct CameraBlockData
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProj;
+};
+
+static const char* uniformNames[] = { "model", "uPickObject" };
+static_assert(sizeof(uniformNames) / sizeof(uniformNames[0]) == static_cast<size_t>(ShaderUniform::Count),
+    "uniformNames must match ShaderUniform");
+
+// ---- mesh shaders ---- //
+// Mesh elements read their state from two texture buffers : uColors (RGBA8,
+// unit 0) and uFlags (R8UI, unit 1; bit 0 = selected, bit 1 = hovered).
+
+static const char* pointVertexShaderSrc = R"(
+layout(location = 0) in vec3 aPos;
+uniform mat4 model;
+uniform samplerBuffer uColors;
+uniform usamplerBuffer uFlags;
+out vec4 vColor;
+void main()
+{
+    uint flags = texelFetch(uFlags, gl_VertexID).r;
+    if ((flags & 1u) != 0u)      vColor = vec4(1.0, 0.5, 0.0, 1.0);
+    else if ((flags & 2u) != 0u) vColor = vec4(1.0, 0.85, 0.3, 1.0);
+    else                         vColor = texelFetch(uColors, gl_VertexID);
+    gl_PointSize = 10.0;
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* pointFragmentShaderSrc = R"(
+in vec4 vColor;
+out vec4 FragColor;
+void main()
+{
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    float dist = dot(coord, coord);
+
+    // draw a circle
+    if (dist > 0.25)
+        discard;
+
+    FragColor = vColor;
+}
+)";
+
+static const char* lineVertexShaderSrc = R"(
+layout(location = 0) in vec3 aPos;
+uniform mat4 model;
+void main()
+{
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* lineFragmentShaderSrc = R"(
+out vec4 FragColor;
+uniform samplerBuffer uColors;
+uniform usamplerBuffer uFlags;
+void main()
+{
+    uint flags = texelFetch(uFlags, gl_PrimitiveID).r;
+    if ((flags & 1u) != 0u)      FragColor = vec4(1.0, 0.5, 0.0, 1.0);
+    else if ((flags & 2u) != 0u) FragColor = vec4(1.0, 0.85, 0.3, 1.0);
+    else                         FragColor = texelFetch(uColors, gl_PrimitiveID);
+}
+)";
+
+static const char* faceVertexShaderSrc = R"(
+layout(location = 0) in vec3 aPos;
+
+uniform mat4 model;
+
+out vec3 vLocalPos;
+
+void main()
+{
+    vLocalPos = aPos;
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* faceFragmentShaderSrc = R"(
+layout(location = 0) out vec4 FragColor;
+
+in vec3 vLocalPos;
+
+uniform samplerBuffer uColors;
+uniform usamplerBuffer uFlags;
+
+void main()
+{
+    vec4 baseColor = texelFetch(uColors, gl_PrimitiveID);
+    uint flags = texelFetch(uFlags, gl_PrimitiveID).r;
+
+    if ((flags & 1u) == 0u)
+    {
+        FragColor = (flags & 2u) != 0u ? vec4(mix(baseColor.rgb, vec3(1.0), 0.25), baseColor.a) : baseColor;
+        return;
+    }
+
+    vec3 orange = vec3(1.0, 0.5, 0.0);
+    vec3 blue   = vec3(0.1, 0.3, 1.0);
+
+    vec2 uv = vLocalPos.xy * vec2(3.0, 3.0);
+
+    float angle = radians(45.0);
+    float c = cos(angle), s = sin(angle);
+    mat2 R = mat2(c, -s, s, c);
+    uv = R * uv;
+
+    float band = step(fract(uv.y), 0.25);
+
+    vec3 finalRGB = mix(orange, blue, band);
+    FragColor = vec4(finalRGB, 1.0);
+}
+)";
+
+// ---- grid shaders ---- //
+
+static const char* gridVertexShaderSrc = R"(
+layout(location = 0) in vec3 aPos;
+uniform mat4 model;
+void main()
+{
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* gridFragmentShaderSrc = R"(
+out vec4 FragColor;
+void main()
+{
+    FragColor = vec4(1.0, 1.0, 1.0, 1.0);
+}
+)";
+
+// ---- picking shaders ---- //
+// Write (object id, element index + 1) to draw buffer 1 of the OpenGLContext
+// framebuffer; 0 means "nothing here".
+
+static const char* pickPointVertexShaderSrc = R"(
+layout(location = 0) in vec3 aPos;
+uniform mat4 model;
+flat out uint vElement;
+void main()
+{
+    vElement = uint(gl_VertexID) + 1u;
+    gl_PointSize = 10.0;
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* pickPointFragmentShaderSrc = R"(
+flat in uint vElement;
+uniform uint uPickObject;
+layout(location = 1) out uvec2 PickID;
+void main()
+{
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    if (dot(coord, coord) > 0.25)
+        discard;
+    PickID = uvec2(uPickObject, vElement);
+}
+)";
+
+static const char* pickPrimitiveFragmentShaderSrc = R"(
+uniform uint uPickObject;
+layout(location = 1) out uvec2 PickID;
+void main()
+{
+    PickID = uvec2(uPickObject, uint(gl_PrimitiveID) + 1u);
+}
+)";
+
+ShaderLibrary& ShaderLibrary::get()
+{
+    static ShaderLibrary instance;
+    return instance;
+}
+
+static unsigned int compileStage(GLenum stage, const char* source)
+{
+    const char* sources[] = { shaderHeaderSrc, source };
+
+    unsigned int shader = glCreateShader(stage);
+    glShaderSource(shader, 2, sources, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled)
+    {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "[ShaderLibrary] Shader compilation failed: " << log << std::endl;
+    }
+    return shader;
+}
+
+unsigned int ShaderLibrary::compileProgram(ShaderKind kind)
+{
+    const char* vsSrc = nullptr;
+    const char* fsSrc = nullptr;
+
+    switch (kind)
+    {
+    case ShaderKind::Point:      vsSrc = pointVertexShaderSrc; fsSrc = pointFragmentShaderSrc; break;
+    case ShaderKind::Line:       vsSrc = lineVertexShaderSrc;  fsSrc = lineFragmentShaderSrc;  break;
+    case ShaderKind::FaceStripe: vsSrc = faceVertexShaderSrc;  fsSrc = faceFragmentShaderSrc;  break;
+    case ShaderKind::Grid:       vsSrc = gridVertexShaderSrc;  fsSrc = gridFragmentShaderSrc;  break;
+    case ShaderKind::PickPoint:  vsSrc = pickPointVertexShaderSrc; fsSrc = pickPointFragmentShaderSrc; break;
+    case ShaderKind::PickPrimitive: vsSrc = lineVertexShaderSrc; fsSrc = pickPrimitiveFragmentShaderSrc; break;
+    default: return 0;
+    }
+
+    unsigned int vertexShader = compileStage(GL_VERTEX_SHADER, vsSrc);
+    unsigned int fragmentShader = compileStage(GL_FRAGMENT_SHADER, fsSrc);
+
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        std::cerr << "[ShaderLibrary] Program link failed: " << log << std::endl;
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return program;
+}
+
+void ShaderLibrary::resolveLocations(ShaderProgram& entry)
+{
+    for (size_t i = 0; i < entry.locations.size(); ++i)
+        entry.locations[i] = glGetUniformLocation(entry.id, uniformNames[i]);
+
+    const GLuint blockIndex = glGetUniformBlockIndex(entry.id, "CameraBlock");
+    if (blockIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(entry.id, blockIndex, kCameraBlockBinding);
+
+    // fixed texture units for the mesh state buffers
+    const GLint colorsLoc = glGetUniformLocation(entry.id, "uColors");
+    const GLint flagsLoc = glGetUniformLocation(entry.id, "uFlags");
+    if (colorsLoc >= 0 || flagsLoc >= 0)
+    {
+        glUseProgram(entry.id);
+        if (colorsLoc >= 0) glUniform1i(colorsLoc, 0);
+        if (flagsLoc >= 0) glUniform1i(flagsLoc, 1);
+        glUseProgram(0);
+    }
+}
+
+const ShaderProgram& ShaderLibrary::program(ShaderKind kind)
+{
+    ShaderProgram& entry = programs[static_cast<size_t>(kind)];
+    if (!entry.isValid())
+    {
+        entry.id = compileProgram(kind);
+        resolveLocations(entry);
+        std::cout << "[ShaderLibrary] Compiled program " << static_cast<int>(kind) << std::endl;
+    }
+    return entry;
+}
+
+void ShaderLibrary::updateCameraBlock(const glm::mat4& view, const glm::mat4& projection)
+{
+    const CameraBlockData data{ view, projection, projection * view };
+
+    if (cameraUbo == 0)
+    {
+        glGenBuffers(1, &cameraUbo);
+        glBindBuffer(GL_UNIFORM_BUFFER, cameraUbo);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlockData), &data, GL_DYNAMIC_DRAW);
+    }
+    else
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, cameraUbo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlockData), &data);
+    }
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, kCameraBlockBinding, cameraUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void ShaderLibrary::destroyAll()
+{
+    for (ShaderProgram& entry : programs)
+    {
+        if (entry.id != 0)
+            glDeleteProgram(entry.id);
+        entry = ShaderProgram{};
+    }
+
+    if (cameraUbo != 0)
+    {
+        glDeleteBuffers(1, &cameraUbo);
+        cameraUbo = 0;
+    }
+}
+
+size_t ShaderLibrary::compiledCount() const
+{
+    size_t count = 0;
+    for (const ShaderProgram& entry : programs)
+        if (entry.isValid()) ++count;
+    return count;
+}
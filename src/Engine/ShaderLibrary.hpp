@@ -0,0 +1,70 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <array>
+
+enum class ShaderKind
+{
+    Point,
+    Line,
+    FaceStripe,
+    Grid,
+    PickPoint,
+    PickPrimitive, // lines and triangles, id = gl_PrimitiveID
+    Count
+};
+
+// Uniforms any library program may declare; locations are resolved once at
+// link time (-1 when the program does not use it).
+enum class ShaderUniform
+{
+    Model,
+    PickObject,
+    Count
+};
+
+// Binding point of the per-frame CameraBlock uniform buffer.
+constexpr unsigned int kCameraBlockBinding = 0;
+
+// Shared handle on a linked program.
+class ShaderProgram
+{
+public:
+    unsigned int getID() const { return id; }
+    bool isValid() const { return id != 0; }
+
+    int location(ShaderUniform u) const { return locations[static_cast<size_t>(u)]; }
+
+private:
+    friend class ShaderLibrary;
+
+    unsigned int id = 0;
+    std::array<int, static_cast<size_t>(ShaderUniform::Count)> locations{};
+};
+
+// Process-wide registry : every distinct program is compiled once, on first
+// use, and shared by all meshes and the scene grid. It also owns the camera
+// uniform buffer that every program reads view / projection from.
+class ShaderLibrary
+{
+public:
+    static ShaderLibrary& get();
+
+    const ShaderProgram& program(ShaderKind kind);
+    void destroyAll();
+
+    // written once per frame by ThreeDScene::render
+    void updateCameraBlock(const glm::mat4& view, const glm::mat4& projection);
+
+    size_t compiledCount() const;
+
+private:
+    ShaderLibrary() = default;
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+    static unsigned int compileProgram(ShaderKind kind);
+    static void resolveLocations(ShaderProgram& entry);
+
+    std::array<ShaderProgram, static_cast<size_t>(ShaderKind::Count)> programs;
+    unsigned int cameraUbo = 0;
+};
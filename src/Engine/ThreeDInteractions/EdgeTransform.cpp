@@ -174,7 +174,6 @@ namespace EdgeTransform
                 glm::vec4 L2 = Pi * W2;
 
                 v->setLocalPosition(glm::vec3(L2));
-                v->setPosition(glm::vec3(W2));
             }
 
             accumDelta = deltaWorld * accumDelta;
@@ -203,7 +202,7 @@ namespace EdgeTransform
             {
                 if (auto* dna = parentMesh->getMeshDNA()) 
                 {
-                     dna->trackEdgeModify(accumDelta, vertsSnapshot);
+                     dna->trackEdgeModify(accumDelta, vertsSnapshot, parentMesh);
                 }
             }
 
@@ -240,7 +239,7 @@ namespace EdgeTransform
 
             if (mesh && a && selected)
             {
-                std::vector<Edge*> loop = MeshEdit::FindLoop(a, selected, mesh, scene, oglChildPos, oglChildSize);
+                std::vector<Edge*> loop = MeshEdit::FindLoop(a, selected, mesh, scene, oglChildPos, oglChildSize, window->edgeLoopCuts);
                 window->isEdgeLoopActive = true;
             }           
         }
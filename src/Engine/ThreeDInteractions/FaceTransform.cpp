@@ -77,15 +77,19 @@ const ImVec2& oglChildSize, bool& wasUsingGizmoLastFrame, bool bakeToVertices)
         ThreeDObject* parent = (vs.empty() || !vs[0]) ? nullptr : vs[0]->getMeshParent();
         const glm::mat4 parentModel = parent ? parent->getModelMatrix() : glm::mat4(1.0f);
 
+        // the selection now holds every cap of the extruded region
         glm::vec3 center(0.0f);
         int count = 0;
 
-        for (auto* v : vs) 
+        for (auto* cap : selectedFaces)
         {
-            if (!v) continue;
-            const glm::vec3 L = v->getLocalPosition();
-            const glm::vec3 W = glm::vec3(parentModel * glm::vec4(L, 1.0f));
-            center += W; ++count;
+            for (auto* v : cap->getVertices())
+            {
+                if (!v) continue;
+                const glm::vec3 L = v->getLocalPosition();
+                const glm::vec3 W = glm::vec3(parentModel * glm::vec4(L, 1.0f));
+                center += W; ++count;
+            }
         }
         if (count > 0) center /= float(count);
 
@@ -220,7 +224,7 @@ const ImVec2& oglChildSize, bool& wasUsingGizmoLastFrame, bool bakeToVertices)
         {
             if (auto* dna = parentMesh->getMeshDNA())
             {
-                dna->trackFaceModify(accumDelta, vertsSnapshot);
+                dna->trackFaceModify(accumDelta, vertsSnapshot, parentMesh);
             }
         }
 
@@ -238,8 +242,6 @@ Face* extrudeSelectedFace(std::list<Face*>& selectedFaces, float distance)
     Face* target = selectedFaces.front();
     if (!target) return nullptr;
 
-    target->setSelected(false);
-
     const auto& vs = target->getVertices();
     if (vs.empty() || !vs[0]) return nullptr;
 
@@ -249,50 +251,56 @@ Face* extrudeSelectedFace(std::list<Face*>& selectedFaces, float distance)
     Mesh* mesh = dynamic_cast<Mesh*>(owner);
     if (!mesh) return nullptr;
 
-    auto& verts = const_cast<std::vector<Vertice*>&>(mesh->getVertices());
-    auto& eds = const_cast<std::vector<Edge*>&>(mesh->getEdges());
-    auto& fs = const_cast<std::vector<Face*>&>(mesh->getFaces());
-
-    const size_t beforeCount = fs.size();
+    // every selected face on the front face's mesh is extruded as one region
+    std::vector<Face*> region;
+    region.reserve(selectedFaces.size());
+    for (Face* f : selectedFaces)
+    {
+        if (!f) continue;
+        f->setSelected(false);
+        const auto& fv = f->getVertices();
+        if (!fv.empty() && fv[0] && fv[0]->getMeshParent() == owner)
+            region.push_back(f);
+    }
 
-    // showErrorBox("FaceTransform.cpp L257 : record creation");
     MeshEdit::ExtrudeResult res{};
-
-    const bool ok = MeshEdit::extrudeQuadFace(mesh, verts, eds, fs, target, distance, &res);
-
-    if (!ok) return nullptr;
+    if (!MeshEdit::extrudeRegion(mesh, region, distance, &res)) return nullptr;
 
         if (auto* dna = mesh->getMeshDNA()) 
         {
             ExtrudeRecord rec{};
-
-            for (int i=0;i<4;++i)
+            auto stamp = [&](const auto& from, auto& to)
             {
-                rec.newVerts[i] = res.newVerts[i];
-                rec.capEdges[i] = res.capEdges[i];
-                rec.upEdges[i]  = res.upEdges[i];
-                rec.sideFaces[i]= res.sideFaces[i];
-                rec.oldVerts[i] = res.oldVerts[i];
-                rec.oldEdges[i] = res.oldEdges[i];
-            }
-            rec.capFace = res.capFace;
+                to.reserve(from.size());
+                for (auto* element : from) to.push_back(mesh->makeRef(element));
+            };
+
+            stamp(res.newVerts, rec.newVerts);
+            stamp(res.capEdges, rec.capEdges);
+            stamp(res.upEdges, rec.upEdges);
+            stamp(res.sideFaces, rec.sideFaces);
+            stamp(res.capFaces, rec.capFaces);
+            stamp(res.movedVerts, rec.movedVerts);
+            stamp(res.oldVerts, rec.oldVerts);
+            stamp(res.oldEdges, rec.oldEdges);
+            rec.movedBy = std::move(res.movedBy);
+            rec.oldSides = std::move(res.oldSides);
             rec.distance = res.distance;
-            dna->trackExtrude(rec);
+            dna->trackExtrude(std::move(rec));
         }
     // ------
 
-    if (fs.empty() || fs.size() <= beforeCount) return nullptr;
-    Face* newCap = fs.back();
-    if (!newCap) return nullptr;
+    if (res.capFaces.empty()) return nullptr;
 
+    // the region faces are gone, the caps take over the selection
     selectedFaces.clear();
+    for (Face* cap : res.capFaces)
+    {
+        cap->setSelected(true);
+        selectedFaces.push_back(cap);
+    }
 
-    for (Face* f : selectedFaces) if (f) f->setSelected(false);
-    selectedFaces.clear();
-    newCap->setSelected(true);
-    selectedFaces.push_back(newCap);
-
-    return newCap;
+    return res.capFaces.front();
 }
 
 }
@@ -139,7 +139,6 @@ namespace VerticeTransform
                 glm::vec4 L2 = Pi * W2;
 
                 v->setLocalPosition(glm::vec3(L2));
-                v->setPosition(glm::vec3(W2));
             }
 
             accumDelta = deltaWorld * accumDelta;
@@ -164,7 +163,7 @@ namespace VerticeTransform
                 if (auto* dna = parentMesh->getMeshDNA()) 
                 {
                     std::cout << "Tracking Vertice modification in Mesh DNA." << std::endl;
-                    dna->trackVerticeModify(accumDelta, vertsSnapshot);
+                    dna->trackVerticeModify(accumDelta, vertsSnapshot, parentMesh);
                 }
             }
             accumDelta = glm::mat4(1.0f);
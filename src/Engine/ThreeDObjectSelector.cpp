@@ -1,28 +1,50 @@
 #include "Engine/ThreeDObjectSelector.hpp"
 #include "WorldObjects/Mesh/Mesh.hpp"
+#include "Engine/ThreeDScene.hpp"
 #include <glm/gtc/matrix_inverse.hpp>
 #include <limits>
 #include <iostream>
 
 #include "Engine/ErrorBox.hpp"
 
+// world-space tolerance for vertex and edge ray picking
+static constexpr float kPickRadius = 0.15f;
+
 ThreeDObjectSelector::ThreeDObjectSelector()
 {
 }
 
-void ThreeDObjectSelector::pickUpMesh(int mouseX, int mouseY, int screenWidth, int screenHeight, const glm::mat4 &view, const glm::mat4 &projection, const std::vector<ThreeDObject *> &objects)
+ThreeDObjectSelector::MeshRay ThreeDObjectSelector::toMeshSpace(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir,
+const ThreeDObject &object, float worldRadius)
+{
+    const glm::mat4 model = object.getModelMatrix();
+    const glm::mat4 invModel = glm::inverse(model);
+
+    MeshRay ray;
+    ray.origin = glm::vec3(invModel * glm::vec4(rayOrigin, 1.0f));
+    ray.dir = glm::vec3(invModel * glm::vec4(rayDir, 0.0f));
+
+    // conservative under non-uniform scale : the smallest axis scale gives the widest local radius
+    const float minScale = std::min(glm::length(glm::vec3(model[0])),
+        std::min(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+    ray.radius = minScale > 1e-8f ? worldRadius / minScale : worldRadius;
+    return ray;
+}
+
+void ThreeDObjectSelector::pickUpMesh(int mouseX, int mouseY, int screenWidth, int screenHeight, const glm::mat4 &view, const glm::mat4 &projection)
 {
     if (screenWidth <= 0 || screenHeight <= 0) 
     {
         std::cerr << "[ThreeDObjectSelector] Invalid screen dimensions" << std::endl;
         return;
     }
+
+    selectedObject = nullptr;
+    if (!pickScene)
+        return;
     
     try 
     {
-        float x = (2.0f * mouseX) / screenWidth - 1.0f;
-        float y = 1.0f - (2.0f * mouseY) / screenHeight;
-
         glm::vec3 rayStart = glm::unProject(glm::vec3(mouseX, mouseY, 0.0f), view, projection, glm::vec4(0, 0, screenWidth, screenHeight));
         glm::vec3 rayEnd = glm::unProject(glm::vec3(mouseX, mouseY, 1.0f), view, projection, glm::vec4(0, 0, screenWidth, screenHeight));
 
@@ -30,114 +52,13 @@ void ThreeDObjectSelector::pickUpMesh(int mouseX, int mouseY, int screenWidth, i
         glm::vec3 rayOrigin = rayStart;
 
         float closestDistance = std::numeric_limits<float>::max();
-        ThreeDObject *closestObject = nullptr;
-
-        for (auto *obj : objects)
-        {
-            if (!obj) continue;
-            if (!obj->isSelectable()) continue;
-            
-            try {
-                Mesh* mesh = dynamic_cast<Mesh*>(obj);
-                if (mesh) {
-                    const auto& verts = mesh->getVertices();
-                    const auto& edges = mesh->getEdges();
-                    const auto& faces = mesh->getFaces();
-                    if (verts.empty() && edges.empty() && faces.empty()) continue;
-                }
-                
-                if (rayIntersectsMesh(rayOrigin, rayDir, *obj))
-                {
-                    float distance = glm::length(obj->getPosition() - rayOrigin);
-                    if (distance < closestDistance)
-                    {
-                        closestDistance = distance;
-                        closestObject = obj;
-                    }
-                }
-            } 
-            catch (const std::exception& e) 
-            {
-                std::cerr << "[ThreeDObjectSelector] Error processing object: " << e.what() << std::endl;
-            }
-        }
-
-        selectedObject = closestObject;
+        selectedObject = pickScene->raycastObjects(rayOrigin, rayDir, closestDistance);
     } 
     catch (const std::exception& e) {
         std::cerr << "[ThreeDObjectSelector] Error during pickUpMesh: " << e.what() << std::endl;
     }
 }
 
-bool ThreeDObjectSelector::rayIntersectsMesh(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, const ThreeDObject &object)
-{
-    try {
-        glm::mat4 model = object.getModelMatrix();
-        if (glm::length(glm::vec3(model[0])) < 0.0001f || 
-            glm::length(glm::vec3(model[1])) < 0.0001f || 
-            glm::length(glm::vec3(model[2])) < 0.0001f) {
-            // Invalid matrix - one of the axes has near-zero length
-            return false;
-        }
-        
-        glm::vec3 center = glm::vec3(model * glm::vec4(0, 0, 0, 1));
-        glm::vec3 halfScale = object.getScale() * 0.5f;
-        
-        // Protect against zero scale
-        if (halfScale.x <= 0.0001f || halfScale.y <= 0.0001f || halfScale.z <= 0.0001f) {
-            return false;
-        }
-
-        glm::vec3 xAxis = glm::normalize(glm::vec3(model[0]));
-        glm::vec3 yAxis = glm::normalize(glm::vec3(model[1]));
-        glm::vec3 zAxis = glm::normalize(glm::vec3(model[2]));
-
-    glm::vec3 delta = center - rayOrigin;
-
-    float tMin = -std::numeric_limits<float>::infinity();
-    float tMax = std::numeric_limits<float>::infinity();
-
-    auto testAxis = [&](const glm::vec3 &axis, float halfSize) -> bool
-    {
-        float e = glm::dot(axis, delta);
-        float f = glm::dot(rayDir, axis);
-
-        if (std::abs(f) > 0.0001f)
-        {
-            float t1 = (e + halfSize) / f;
-            float t2 = (e - halfSize) / f;
-
-            if (t1 > t2)
-                std::swap(t1, t2);
-            if (t1 > tMin)
-                tMin = t1;
-            if (t2 < tMax)
-                tMax = t2;
-            if (tMin > tMax)
-                return false;
-        }
-        else if (-e - halfSize > 0.0f || -e + halfSize < 0.0f)
-        {
-            return false;
-        }
-
-        return true;
-    };
-
-    bool result = testAxis(xAxis, halfScale.x) &&
-                testAxis(yAxis, halfScale.y) &&
-                testAxis(zAxis, halfScale.z);
-
-
-    return result;
-    } 
-    catch (const std::exception& e) 
-    {
-        std::cerr << "[ThreeDObjectSelector] Error in rayIntersectsMesh: " << e.what() << std::endl;
-        return false;
-    }
-}
-
 void ThreeDObjectSelector::clearTarget()
 {
     selectedObject = nullptr;
@@ -155,11 +76,40 @@ void ThreeDObjectSelector::clearMultipleSelection()
 }
 
 
+void ThreeDObjectSelector::clearElementSelection(const std::vector<ThreeDObject *> &objects, PickTarget target)
+{
+    for (ThreeDObject* obj : objects)
+    {
+        if (!obj || !obj->isSelectable() || !obj->getIsMesh()) continue;
+
+        Mesh* mesh = static_cast<Mesh*>(obj);
+        switch (target)
+        {
+        case PickTarget::Vertice:
+            for (Vertice* v : mesh->getVertices()) if (v) v->setSelected(false);
+            break;
+        case PickTarget::Edge:
+            for (Edge* e : mesh->getEdges()) if (e) e->setSelected(false);
+            break;
+        case PickTarget::Face:
+            for (Face* f : mesh->getFaces()) if (f) f->setSelected(false);
+            break;
+        }
+    }
+}
+
 // -------- Vertice Selection --------
 
 Vertice* ThreeDObjectSelector::pickUpVertice(int mouseX, int mouseY, int screenWidth, int screenHeight, 
 const glm::mat4& view, const glm::mat4& projection, const std::vector<ThreeDObject*>& objects, bool clearPrevious)
 {
+    PickHit hit;
+    if (pickScene && pickScene->pickElement(PickTarget::Vertice, mouseX, mouseY, screenWidth, screenHeight, hit))
+    {
+        if (clearPrevious)
+            clearElementSelection(objects, PickTarget::Vertice);
+        return hit.vertice;
+    }
 
     glm::vec3 rayStart = glm::unProject(glm::vec3(mouseX, mouseY, 0.0f),
     view, projection, glm::vec4(0, 0, screenWidth, screenHeight));
@@ -186,18 +136,17 @@ const glm::mat4& view, const glm::mat4& projection, const std::vector<ThreeDObje
                 v->setSelected(false);
         }
 
-        for (Vertice* v : mesh->getVertices()) 
+        const MeshRay ray = toMeshSpace(rayOrigin, rayDir, *obj, kPickRadius);
+        candidateVertices.clear();
+        mesh->getBVH().queryVertices(*mesh, ray.origin, ray.dir, ray.radius, candidateVertices);
+
+        for (Vertice* v : candidateVertices) 
         {
-            glm::mat4 modelMatrix = obj->getModelMatrix();
-            glm::vec3 worldPos = glm::vec3(modelMatrix * glm::vec4(v->getLocalPosition(), 1.0f));
-            v->setPosition(worldPos);
-
-            if (rayIntersectsVertice(rayOrigin, rayDir, *obj, *v)) {
-                float distance = glm::length(v->getPosition() - rayOrigin);
-                if (distance < closestDistance) {
-                    closestDistance = distance;
-                    closestVertice  = v;
-                }
+            float distance = 0.0f;
+            if (rayIntersectsVertice(ray, *v, distance) && distance < closestDistance)
+            {
+                closestDistance = distance;
+                closestVertice  = v;
             }
         }
     }
@@ -206,21 +155,21 @@ const glm::mat4& view, const glm::mat4& projection, const std::vector<ThreeDObje
     return closestVertice;
 }
 
-bool ThreeDObjectSelector::rayIntersectsVertice(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, const ThreeDObject &object, const Vertice &vertice)
+bool ThreeDObjectSelector::rayIntersectsVertice(const MeshRay &ray, const Vertice &vertice, float &outDistance)
 {
-    const float radius = 0.15f;
-
-    glm::vec3 vertWorldPos = vertice.getPosition();
-    glm::vec3 toVert = vertWorldPos - rayOrigin;
+    const glm::vec3 toVert = vertice.getLocalPosition() - ray.origin;
 
-    float projectionLength = glm::dot(toVert, rayDir);
+    const float dd = glm::dot(ray.dir, ray.dir);
+    const float projectionLength = dd > 0.0f ? glm::dot(toVert, ray.dir) / dd : 0.0f;
     if (projectionLength < 0.0f)
         return false;
 
-    glm::vec3 projectedPoint = rayOrigin + rayDir * projectionLength;
-    float distance = glm::length(projectedPoint - vertWorldPos);
+    glm::vec3 projectedPoint = ray.origin + ray.dir * projectionLength;
+    if (glm::length(projectedPoint - vertice.getLocalPosition()) >= ray.radius)
+        return false;
 
-    return distance < radius;
+    outDistance = projectionLength;
+    return true;
 }
 
 
@@ -229,6 +178,16 @@ bool ThreeDObjectSelector::rayIntersectsVertice(const glm::vec3 &rayOrigin, cons
 Face* ThreeDObjectSelector::pickupFace(int mouseX, int mouseY, int screenWidth, int screenHeight,
 const glm::mat4 &view, const glm::mat4 &projection, const std::vector<ThreeDObject *> &objects, bool clearPrevious)
 {
+    PickHit hit;
+    if (pickScene && pickScene->pickElement(PickTarget::Face, mouseX, mouseY, screenWidth, screenHeight, hit))
+    {
+        if (clearPrevious)
+            clearElementSelection(objects, PickTarget::Face);
+        if (hit.face)
+            hit.face->setSelected(true);
+        return hit.face;
+    }
+
     glm::vec3 rayStart = glm::unProject(glm::vec3(mouseX, mouseY, 0.0f),
     view, projection, glm::vec4(0, 0, screenWidth, screenHeight));
 
@@ -254,37 +213,12 @@ const glm::mat4 &view, const glm::mat4 &projection, const std::vector<ThreeDObje
                 if (f) f->setSelected(false);
         }
 
-        const glm::mat4 model = obj->getModelMatrix();
-
-        for (Face* f : mesh->getFaces())
+        float distance = 0.0f;
+        Face* f = rayIntersectsFace(rayOrigin, rayDir, *mesh, distance);
+        if (f && distance < closestDistance)
         {
-            if (!f) continue;
-
-            if (!rayIntersectsFace(rayOrigin, rayDir, *obj, *f))
-                continue;
-
-            const auto& verts = f->getVertices();
-            if (verts.size() < 4) continue;
-
-            glm::vec3 p0 = glm::vec3(model * glm::vec4(verts[0]->getLocalPosition(), 1.0f));
-            glm::vec3 p1 = glm::vec3(model * glm::vec4(verts[1]->getLocalPosition(), 1.0f));
-            glm::vec3 p2 = glm::vec3(model * glm::vec4(verts[2]->getLocalPosition(), 1.0f));
-
-            glm::vec3 n = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-            float denom = glm::dot(n, rayDir);
-            if (std::abs(denom) < 1e-6f) continue;
-
-            float t = glm::dot(n, (p0 - rayOrigin)) / denom;
-            if (t < 0.0f) continue;
-
-            glm::vec3 hitPoint = rayOrigin + t * rayDir;
-            float distance = glm::length(hitPoint - rayOrigin);
-
-            if (distance < closestDistance)
-            {
-                closestDistance = distance;
-                closestFace = f;
-            }
+            closestDistance = distance;
+            closestFace = f;
         }
     }
 
@@ -294,61 +228,27 @@ const glm::mat4 &view, const glm::mat4 &projection, const std::vector<ThreeDObje
     return closestFace;
 }
 
-bool ThreeDObjectSelector::rayIntersectsFace(const glm::vec3 &rayOrigin, 
-const glm::vec3 &rayDir, const ThreeDObject &object, const Face &face)
+Face* ThreeDObjectSelector::rayIntersectsFace(const glm::vec3 &rayOrigin, 
+const glm::vec3 &rayDir, Mesh &mesh, float &outDistance)
 {
-    const glm::mat4 model = object.getModelMatrix();
-
-    const auto& verts = face.getVertices();
-    if (verts.size() < 4) return false;
-
-    glm::vec3 p0 = glm::vec3(model * glm::vec4(verts[0]->getLocalPosition(), 1.0f));
-    glm::vec3 p1 = glm::vec3(model * glm::vec4(verts[1]->getLocalPosition(), 1.0f));
-    glm::vec3 p2 = glm::vec3(model * glm::vec4(verts[2]->getLocalPosition(), 1.0f));
-    glm::vec3 p3 = glm::vec3(model * glm::vec4(verts[3]->getLocalPosition(), 1.0f));
-
-    glm::vec3 n = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-    float denom = glm::dot(n, rayDir);
-    if (std::abs(denom) < 1e-6f)
-        return false; 
-
-    float t = glm::dot(n, (p0 - rayOrigin)) / denom;
-    if (t < 0.0f)
-        return false;
+    // rayDir is normalized, so the hit parameter is the world distance
+    const MeshRay ray = toMeshSpace(rayOrigin, rayDir, mesh, 0.0f);
 
-    glm::vec3 P = rayOrigin + t * rayDir;
-
-    auto pointInTri = [&](const glm::vec3& A, const glm::vec3& B, const glm::vec3& C, const glm::vec3& Pnt) -> bool
-    {
-        glm::vec3 c0 = glm::cross(B - A, Pnt - A);
-        glm::vec3 c1 = glm::cross(C - B, Pnt - B);
-        glm::vec3 c2 = glm::cross(A - C, Pnt - C);
-        float d0 = glm::dot(c0, n);
-        float d1 = glm::dot(c1, n);
-        float d2 = glm::dot(c2, n);
-        const float eps = -1e-6f;
-        return (d0 >= eps) && (d1 >= eps) && (d2 >= eps);
-    };
-
-
-    bool inside = pointInTri(p0, p1, p2, P) || pointInTri(p0, p2, p3, P);
-    return inside;
+    Face* face = nullptr;
+    if (!mesh.getBVH().raycastFaces(mesh, ray.origin, ray.dir, outDistance, face))
+        return nullptr;
+    return face;
 }
 
 
 // ----------- Edge Selection --------
 
-bool ThreeDObjectSelector::rayIntersectsEdge(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, 
-const ThreeDObject &object, const Edge &edge)
+bool ThreeDObjectSelector::rayIntersectsEdge(const MeshRay &ray, const Edge &edge, float &outS)
 {
-    const float radius = 0.15f;
-
-    glm::mat4 model = object.getModelMatrix();
-    glm::vec3 a0 = glm::vec3(model * glm::vec4(edge.getStart()->getLocalPosition(), 1.0f));
-    glm::vec3 b0 = glm::vec3(model * glm::vec4(edge.getEnd()->getLocalPosition(),   1.0f));
-    glm::vec3 v = b0 - a0;
-    glm::vec3 u = glm::normalize(rayDir);
-    glm::vec3 w0 = rayOrigin - a0;
+    const glm::vec3 a0 = edge.getStart()->getLocalPosition();
+    const glm::vec3 v = edge.getEnd()->getLocalPosition() - a0;
+    const glm::vec3 u = ray.dir;
+    const glm::vec3 w0 = ray.origin - a0;
 
     float a = glm::dot(u, u);
     float b = glm::dot(u, v);
@@ -357,8 +257,9 @@ const ThreeDObject &object, const Edge &edge)
     float e = glm::dot(v, w0);
     float D = a * c - b * b;
 
+    // u is not unit length in local space, so parallel is judged relative to it
     float s, t;
-    if (D > 1e-6f)
+    if (D > 1e-6f * a * c)
     {
         s = (b * e - c * d) / D;
         t = (a * e - b * d) / D;
@@ -377,16 +278,27 @@ const ThreeDObject &object, const Edge &edge)
 
     t = glm::clamp(t, 0.0f, 1.0f);
 
-    glm::vec3 pc = rayOrigin + s * u;
+    glm::vec3 pc = ray.origin + s * u;
     glm::vec3 qc = a0 + t * v;
 
-    float dist = glm::length(pc - qc);
-    return dist < radius && s >= 0.0f;
+    if (glm::length(pc - qc) >= ray.radius)
+        return false;
+
+    outS = s;
+    return true;
 }
 
 Edge* ThreeDObjectSelector::pickupEdge(int mouseX, int mouseY, int screenWidth, int screenHeight, 
 const glm::mat4 &view, const glm::mat4 &projection, const std::vector<ThreeDObject *> &objects, bool clearPrevious)
 {
+    PickHit hit;
+    if (pickScene && pickScene->pickElement(PickTarget::Edge, mouseX, mouseY, screenWidth, screenHeight, hit))
+    {
+        if (clearPrevious)
+            clearElementSelection(objects, PickTarget::Edge);
+        return hit.edge;
+    }
+
     glm::vec3 rayStart = glm::unProject(glm::vec3(mouseX, mouseY, 0.0f), view, projection, glm::vec4(0, 0, screenWidth, screenHeight));
     glm::vec3 rayEnd   = glm::unProject(glm::vec3(mouseX, mouseY, 1.0f), view, projection, glm::vec4(0, 0, screenWidth, screenHeight));
     glm::vec3 rayDir   = glm::normalize(rayEnd - rayStart);
@@ -408,51 +320,17 @@ const glm::mat4 &view, const glm::mat4 &projection, const std::vector<ThreeDObje
                 e->setSelected(false);
         }
 
-        for (Edge* e : mesh->getEdges())
-        {
-            if (!e || !e->getStart() || !e->getEnd()) continue;
+        const MeshRay ray = toMeshSpace(rayOrigin, rayDir, *obj, kPickRadius);
+        candidateEdges.clear();
+        mesh->getBVH().queryEdges(*mesh, ray.origin, ray.dir, ray.radius, candidateEdges);
 
-            if (rayIntersectsEdge(rayOrigin, rayDir, *obj, *e))
+        for (Edge* e : candidateEdges)
+        {
+            float s = 0.0f;
+            if (rayIntersectsEdge(ray, *e, s) && s < closestS)
             {
-                glm::mat4 model = obj->getModelMatrix();
-                glm::vec3 a0 = glm::vec3(model * glm::vec4(e->getStart()->getLocalPosition(), 1.0f));
-                glm::vec3 b0 = glm::vec3(model * glm::vec4(e->getEnd()->getLocalPosition(),   1.0f));
-                glm::vec3 v = b0 - a0;
-                glm::vec3 u = glm::normalize(rayDir);
-                glm::vec3 w0 = rayOrigin - a0;
-
-                float a = glm::dot(u, u);
-                float b = glm::dot(u, v);
-                float c = glm::dot(v, v);
-                float d = glm::dot(u, w0);
-                float ee = glm::dot(v, w0);
-                float D = a * c - b * b;
-
-                float s, t;
-                if (D > 1e-6f)
-                {
-                    s = (b * ee - c * d) / D;
-                    t = (a * ee - b * d) / D;
-                }
-                else
-                {
-                    s = 0.0f;
-                    t = c > 0.0f ? ee / c : 0.0f;
-                }
-
-                if (s < 0.0f)
-                {
-                    s = 0.0f;
-                    t = c > 0.0f ? ee / c : 0.0f;
-                }
-
-                t = glm::clamp(t, 0.0f, 1.0f);
-
-                if (s >= 0.0f && s < closestS)
-                {
-                    closestS = s;
-                    closestEdge = e;
-                }
+                closestS = s;
+                closestEdge = e;
             }
         }
     }
@@ -8,14 +8,22 @@
 #include <iostream>
 #include <list>
 
+class ThreeDScene;
+class Mesh;
+enum class PickTarget;
+
 class ThreeDObjectSelector
 {
 public:
     ThreeDObjectSelector();
 
+    // objects are picked through the scene's BVH; element picking goes through
+    // its GPU id pass when set, otherwise falls back to the ray tests below
+    void setPickScene(ThreeDScene* scene) { pickScene = scene; }
+
 // -------- Mesh Picking --------
 
-    void pickUpMesh(int mouseX, int mouseY, int screenWidth, int screenHeight, const glm::mat4 &view, const glm::mat4 &projection, const std::vector<ThreeDObject *> &objects);
+    void pickUpMesh(int mouseX, int mouseY, int screenWidth, int screenHeight, const glm::mat4 &view, const glm::mat4 &projection);
     void clearTarget();
     void select(ThreeDObject *object);
 
@@ -42,11 +50,27 @@ public:
 private:
     ThreeDObject *selectedObject = nullptr;
     std::list<ThreeDObject *> multipleSelectedObjects;
-
-    bool rayIntersectsMesh(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, const ThreeDObject &object);
-    bool rayIntersectsVertice(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, const ThreeDObject &object, const Vertice &vertice);
-    bool rayIntersectsFace(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, const ThreeDObject &object, const Face &face);
-    bool rayIntersectsEdge(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, const ThreeDObject &object, const Edge &edge);
+    ThreeDScene* pickScene = nullptr;
+
+    // world ray expressed in a mesh's local space, for its BVH
+    struct MeshRay
+    {
+        glm::vec3 origin;
+        glm::vec3 dir;
+        float radius;
+    };
+    static MeshRay toMeshSpace(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, const ThreeDObject &object, float worldRadius);
+
+    std::vector<Vertice*> candidateVertices;
+    std::vector<Edge*> candidateEdges;
+
+    void clearElementSelection(const std::vector<ThreeDObject *> &objects, PickTarget target);
+
+    // both test in the mesh's local space; the ray parameter they give back is
+    // the world distance along the ray, since ray.dir maps to a unit world direction
+    static bool rayIntersectsVertice(const MeshRay &ray, const Vertice &vertice, float &outDistance);
+    Face* rayIntersectsFace(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir, Mesh &mesh, float &outDistance);
+    static bool rayIntersectsEdge(const MeshRay &ray, const Edge &edge, float &outS);
     
 
 };
@@ -5,6 +5,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include "Engine/ThreeDScene.hpp"
+#include "Engine/ShaderLibrary.hpp"
+#include "Engine/Frustum.hpp"
+#include "Engine/SceneRevision.hpp"
 #include <iostream>
 #include <filesystem>
 #include <vector>
@@ -16,29 +19,6 @@
 #include "ErrorBox.hpp"
 #include "json.hpp"
 
-// === SHADERS ===
-
-const char *vertexShaderSource = R"(
-#version 330 core
-layout(location = 0) in vec3 aPos;
-uniform mat4 viewProj;
-uniform mat4 model;
-void main()
-{
-    
-    gl_Position = viewProj * model * vec4(aPos, 1.0);
-}
-)";
-
-const char *fragmentShaderSource = R"(
-#version 330 core
-out vec4 FragColor;
-void main()
-{
-    FragColor = vec4(1.0, 1.0, 1.0, 1.0);
-}
-)";
-
 // === CLASS ===
 ThreeDScene::ThreeDScene() {}
 
@@ -139,10 +119,12 @@ void ThreeDScene::pushInGraveyard(ThreeDObject* obj)
         }
         
         erasePtr(objects, child);
+        sceneBVH.remove(child);
         graveyard.push_back(child);
     }
     
     erasePtr(objects, obj);
+    sceneBVH.remove(obj);
     graveyard.push_back(obj);
 
     if (auto* mesh = dynamic_cast<Mesh*>(obj))
@@ -158,27 +140,6 @@ void ThreeDScene::pushInGraveyard(ThreeDObject* obj)
 }
 
 
-void ThreeDScene::compileShaders()
-{
-	unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-	glCompileShader(vertexShader);
-
-	unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-	glCompileShader(fragmentShader);
-
-	shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-	glLinkProgram(shaderProgram);
-
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
-
-	
-}
-
 void ThreeDScene::setSceneDNA(ThreeDScene_DNA* dna, bool takeOwnership)
 {
     if (sceneDNA && ownsSceneDNA && sceneDNA != dna) {
@@ -191,8 +152,6 @@ void ThreeDScene::setSceneDNA(ThreeDScene_DNA* dna, bool takeOwnership)
 
 void ThreeDScene::initizalize()
 {
-    compileShaders();
-
     if (!sceneDNA)
     {
         auto* dna = new ThreeDScene_DNA();
@@ -234,6 +193,7 @@ void ThreeDScene::initizalize()
 void ThreeDScene::resize(int w, int h)
 {
     if (glctx) glctx->resize(w, h);
+    SceneRevision::bump();
 }
 
 
@@ -250,10 +210,6 @@ void ThreeDScene::render()
         return;
     }
 
-    glctx->bindForRendering();
-
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
     const int w = glctx->getWidth();
     const int h = glctx->getHeight();
     const float aspect = (h > 0) ? float(w) / float(h) : 1.0f;
@@ -262,6 +218,23 @@ void ThreeDScene::render()
     glm::mat4 proj = activeCamera->getProjectionMatrix(aspect);
     glm::mat4 viewProj = proj * view;
 
+    // the FBO still holds the last image; camera moves are caught by the matrix
+    // and list edits that bypass addObject by the object count
+    const uint64_t revision = SceneRevision::current();
+    if (revision == renderedRevision && viewProj == renderedViewProj && objects.size() == renderedObjectCount)
+    {
+        redrewLastFrame = false;
+        return;
+    }
+    renderedRevision = revision;
+    renderedViewProj = viewProj;
+    renderedObjectCount = objects.size();
+    redrewLastFrame = true;
+
+    glctx->bindForRendering();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
     if (!ownsViewproj) 
     {
         lastViewProj = viewProj;
@@ -269,21 +242,35 @@ void ThreeDScene::render()
         ownsViewproj = true;
     }
 
+    ShaderLibrary::get().updateCameraBlock(view, proj);
+
     glDisable(GL_DEPTH_TEST);
     drawBackgroundGradient();
     glEnable(GL_DEPTH_TEST);
 
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "viewProj"), 1, GL_FALSE, glm::value_ptr(viewProj));
+    const ShaderProgram& gridProgram = ShaderLibrary::get().program(ShaderKind::Grid);
+    glUseProgram(gridProgram.getID());
 
     glBindVertexArray(gridVAO);
     glm::mat4 model(1.0f);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(gridProgram.location(ShaderUniform::Model), 1, GL_FALSE, glm::value_ptr(model));
     glDrawArrays(GL_LINES, 0, 44);
     glBindVertexArray(0);
 
+    const Frustum frustum = Frustum::fromViewProj(viewProj);
+    glm::vec3 boundsMin, boundsMax;
+    culledCount = 0;
+
     for (auto *obj : objects) {
-        if (obj) obj->render(viewProj);
+        if (!obj) continue;
+
+        if (obj->getLocalBounds(boundsMin, boundsMax)
+            && !frustum.intersectsAABB(boundsMin, boundsMax, obj->getModelMatrix()))
+        {
+            ++culledCount;
+            continue;
+        }
+        obj->render(viewProj);
     }
 
     glctx->unbind();
@@ -291,6 +278,21 @@ void ThreeDScene::render()
 
 
 
+bool ThreeDScene::pickElement(PickTarget target, int x, int y, int viewportWidth, int viewportHeight, PickHit& outHit)
+{
+    if (!glctx || !activeCamera)
+        return false;
+
+    return picker.pick(*glctx, objects, getViewMatrix(), getProjectionMatrix(), target,
+        x, y, viewportWidth, viewportHeight, outHit);
+}
+
+ThreeDObject* ThreeDScene::raycastObjects(const glm::vec3& rayOrigin, const glm::vec3& rayDir, float& outDistance)
+{
+    sceneBVH.update();
+    return sceneBVH.raycast(rayOrigin, rayDir, outDistance);
+}
+
 void ThreeDScene::drawBackgroundGradient()
 {
 	glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
@@ -301,6 +303,8 @@ void ThreeDScene::addObject(ThreeDObject* object)
     if (!object) return;
 
     objects.push_back(object);
+    sceneBVH.insert(object);
+    SceneRevision::bump();
     std::cout << "[ThreeDScene] Adding object: " << object->getName() << std::endl;
 
     if (auto* sdna = getSceneDNA())
@@ -326,6 +330,15 @@ void ThreeDScene::addObject(ThreeDObject* object)
     object->initialize();
 }
 
+void ThreeDScene::restoreObject(ThreeDObject* object)
+{
+    if (!object || containsObject(object)) return;
+
+    objects.push_back(object);
+    sceneBVH.insert(object);
+    SceneRevision::bump();
+}
+
 bool ThreeDScene::removeObject(ThreeDObject* object)
 {
 
@@ -352,6 +365,7 @@ bool ThreeDScene::removeObject(ThreeDObject* object)
         sdna->trackRemoveObject(object->getName(), object);
 
     pushInGraveyard(object);
+    SceneRevision::bump();
     hierarchyInspector->redrawSlotsList();
     return true;
 }
@@ -368,6 +382,7 @@ bool ThreeDScene::removeObjectFromSceneDNA(uint64_t objectID)
 
             obj->destroy();
             erasePtr(objects, obj);
+            sceneBVH.remove(obj);
             return true;
         }
     }
@@ -8,6 +8,8 @@
 #include <WorldObjects/Entities/ThreeDObject.hpp>
 #include "WorldObjects/Camera/Camera.hpp"
 #include "Engine/ThreeDScene_DNA/ThreeDScene_DNA.hpp"
+#include "Engine/GpuPicker.hpp"
+#include "Engine/SceneBVH.hpp"
 #include <iostream>
 #include <list>
 #include <json.hpp>
@@ -40,10 +42,18 @@ public:
 
     void initizalize();
     void resize(int w, int h);
+    // redraws into the FBO only when SceneRevision, the camera or the size changed
     void render();
+    bool didRedrawLastFrame() const { return redrewLastFrame; }
     void drawBackgroundGradient();
 
     GLuint getTexture() const; 
+
+    // GPU id-buffer picking; false when no context is available (callers fall back to rays)
+    bool pickElement(PickTarget target, int x, int y, int viewportWidth, int viewportHeight, PickHit& outHit);
+    // nearest selectable object under a world ray, through the scene BVH
+    ThreeDObject* raycastObjects(const glm::vec3& rayOrigin, const glm::vec3& rayDir, float& outDistance);
+    size_t getCulledCount() const { return culledCount; }
     std::vector<glm::vec3> worldCenter;
 
     std::list<ThreeDObject*>& getObjectsRef() 
@@ -53,6 +63,8 @@ public:
     }
     void addObject(ThreeDObject* object);
     bool removeObject(ThreeDObject* object);
+    // puts an object back in the scene list without tracking it (DNA rewinds)
+    void restoreObject(ThreeDObject* object);
 
     void pushInGraveyard(ThreeDObject * obj);
     // bool reviveFromGraveyardById(uint64_t id);
@@ -86,6 +98,13 @@ private:
     ThreeDWindow* threeDWindow = nullptr;
 
     glm::mat4 lastViewProj{1.0f};
+    size_t culledCount = 0;
+
+    // ---- render on demand ---- //
+    uint64_t renderedRevision = 0;
+    glm::mat4 renderedViewProj{0.0f};
+    size_t renderedObjectCount = 0;
+    bool redrewLastFrame = false;
     std::list<ThreeDObject *> objects;
     std::list<ThreeDObject *> graveyard;
     std::vector<GraveyardEntry> meshGraveyard;
@@ -94,11 +113,11 @@ private:
     Camera* activeCamera{nullptr};
 
     OpenGLContext* glctx{nullptr};
+    GpuPicker picker;
+    SceneBVH sceneBVH;
 
-    void compileShaders();
     GLuint gridVAO;
     GLuint gridVBO;
-    GLuint shaderProgram;
     ThreeDScene_DNA* sceneDNA{nullptr};
     
     bool ownsSceneDNA{true};
@@ -215,7 +215,6 @@ void ThreeDScene_DNA::resurrectChildrenRecursive(ThreeDObject* parent)
     
     auto& graveyard = const_cast<std::list<ThreeDObject*>&>(sceneRef->getGraveyard());
     auto& meshGraveyard = const_cast<std::vector<GraveyardEntry>&>(sceneRef->getMeshGraveyard());
-    auto& objects = sceneRef->getObjectsRef();
     
     std::vector<ThreeDObject*> childrenToResurrect;
     
@@ -237,8 +236,7 @@ void ThreeDScene_DNA::resurrectChildrenRecursive(ThreeDObject* parent)
     {
         child->setSelected(false);
         
-        if (std::find(objects.begin(), objects.end(), child) == objects.end())
-            objects.push_back(child);
+        sceneRef->restoreObject(child);
         
         if (auto* mesh = dynamic_cast<Mesh*>(child))
         {
@@ -330,8 +328,7 @@ void ThreeDScene_DNA::cancelLastRemoveObject(size_t preserveIndex)
                 resurrect->removeParent();
                 resurrect->setModelMatrix(G);
 
-                if (std::find(objects.begin(), objects.end(), resurrect) == objects.end())
-                    objects.push_back(resurrect);
+                sceneRef->restoreObject(resurrect);
 
                 if (auto* mesh = dynamic_cast<Mesh*>(resurrect))
                 {
@@ -395,8 +392,7 @@ void ThreeDScene_DNA::cancelRemoveObjectByID(uint64_t objectID)
             {
                 resurrect->setSelected(false);
 
-                if (std::find(objects.begin(), objects.end(), resurrect) == objects.end())
-                    objects.push_back(resurrect);
+                sceneRef->restoreObject(resurrect);
 
                 if (auto* mesh = dynamic_cast<Mesh*>(resurrect))
                 {
@@ -7,6 +7,7 @@
 #include "Engine/OpenGLContext.hpp"
 #include "WorldObjects/Mesh/Mesh.hpp"
 #include "Engine/PrimitivesCreation/CreatePrimitive.hpp"
+#include "Engine/MeshEdit/Subdivide.hpp"
 #include "Engine/ErrorBox.hpp"
 #include <iostream>
 #include <algorithm>
@@ -151,6 +152,24 @@ void ContextualMenu::render()
 					ImGui::End();
 					return;
 				}
+
+				if (Mesh* mesh = dynamic_cast<Mesh*>(selected))
+				{
+					if (ImGui::MenuItem("Subdivide (Catmull-Clark)"))
+					{
+						MeshEdit::Subdivide(mesh, 1);
+						hide();
+						ImGui::End();
+						return;
+					}
+					if (ImGui::MenuItem("Merge by distance"))
+					{
+						mesh->weldByDistance(1e-4f);
+						hide();
+						ImGui::End();
+						return;
+					}
+				}
 			}
 
 			if (ImGui::MenuItem("Create Cube"))
@@ -16,6 +16,12 @@ void EdgeLoopControl::render()
 	if (isOpen) {
 		ImGui::Begin("EdgeLoopControl", &isOpen, ImGuiWindowFlags_AlwaysAutoResize);
 		ImGui::Text("EdgeLoopControl");
+		renderCutCount();
 		ImGui::End();
 	}
 }
+
+void EdgeLoopControl::renderCutCount()
+{
+	ImGui::SliderInt("Cuts", &cuts, 1, 64);
+}
@@ -9,6 +9,11 @@ public:
     void hide();
 	void render();
 
+	// number of parallel loops the next edge loop cut inserts
+	void renderCutCount();
+	int getCuts() const { return cuts; }
+
 private:
 	bool isOpen = false;
+	int cuts = 1;
 };
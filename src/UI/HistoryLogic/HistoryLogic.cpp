@@ -271,6 +271,13 @@ void HistoryLogic::render()
 								line = "#" + std::to_string(i) + "  Extrude Face";
 								line += " (dist=" + std::to_string(ev.extrude.distance) + ")";
 							}
+							else if (ev.kind == ComponentEditKind::Topology)
+							{
+								line = "#" + std::to_string(i) + "  Edit Topology (" + ev.tag + ")";
+								line += " (verts=" + std::to_string(ev.topology.verticeDelta) +
+								", edges=" + std::to_string(ev.topology.edgeDelta) +
+								", faces=" + std::to_string(ev.topology.faceDelta) + ")";
+							}
 							else
 							{								
 								const glm::vec3 t(ev.delta[3]);
@@ -294,10 +301,7 @@ void HistoryLogic::render()
 
 							MeshTransform::applyGizmoTransformation(scene, delta, one, op);
 							
-							dna->rewindEdgeHistory(i, mesh);
-							dna->rewindVerticeHistory(i, mesh);
-							dna->rewindFaceHistory(i, mesh);
-							dna->rewindExtrudeHistory(i, mesh);
+							dna->rewindComponentHistory(i, mesh);
 							dna->rewindToAndApply(i, mesh);
 
 							ImGui::End();
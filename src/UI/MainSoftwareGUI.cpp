@@ -21,6 +21,8 @@
 #include <filesystem>
 
 #include "Engine/ErrorBox.hpp"
+#include "Engine/ShaderLibrary.hpp"
+#include "Engine/ThreeDScene.hpp"
 #include "Engine/SaveLoadSystem/Save_Scene.hpp"
 
 namespace fs = std::filesystem;
@@ -129,6 +131,8 @@ void MainSoftwareGUI::DisplayEdgeLoopControl(ThreeDWindow *window)
 
 		ImGui::Begin("EdgeLoopControl", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDocking);
 		ImGui::Text("EdgeLoopControl");
+		edgeLoopControl->renderCutCount();
+		window->edgeLoopCuts = edgeLoopControl->getCuts();
 
 		if (ImGui::IsWindowHovered(ImGuiHoveredFlags_AllowWhenBlockedByPopup) && ImGui::IsMouseDown(ImGuiMouseButton_Left))
 		{
@@ -197,6 +201,32 @@ void MainSoftwareGUI::initImGui()
 	tryLoadLayout();
 }
 
+// ---- idle throttling ---- //
+// ImGui needs a couple of frames to settle after any input; once the scene
+// stopped redrawing and nothing is being typed, dragged or held, the loop
+// blocks on glfwWaitEventsTimeout instead of spinning.
+
+static constexpr int kSettleFrames = 3;
+static constexpr double kIdleWaitSeconds = 0.5;
+
+static bool hasPendingInput()
+{
+	const ImGuiIO &io = ImGui::GetIO();
+
+	if (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f) return true;
+	if (io.MouseWheel != 0.0f || io.MouseWheelH != 0.0f) return true;
+	if (io.InputQueueCharacters.Size > 0) return true;
+	if (ImGui::IsAnyItemActive()) return true;
+
+	for (int b = 0; b < ImGuiMouseButton_COUNT; ++b)
+		if (io.MouseDown[b]) return true;
+
+	for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; ++key)
+		if (ImGui::IsKeyDown(static_cast<ImGuiKey>(key))) return true;
+
+	return false;
+}
+
 void MainSoftwareGUI::run()
 {
 
@@ -210,10 +240,15 @@ void MainSoftwareGUI::run()
 
 	static bool isFaceModeActive = false;
 
+	int idleFrames = 0;
 
 	while (!glfwWindowShouldClose(window))
 	{
-		glfwPollEvents();
+		if (idleFrames >= kSettleFrames)
+			glfwWaitEventsTimeout(kIdleWaitSeconds);
+		else
+			glfwPollEvents();
+
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
@@ -323,6 +358,8 @@ void MainSoftwareGUI::run()
 		glfwMakeContextCurrent(window);
 		glfwSwapBuffers(window);
 
+		const bool sceneRedrawn = sceneRef && sceneRef->didRedrawLastFrame();
+		idleFrames = (sceneRedrawn || hasPendingInput()) ? 0 : idleFrames + 1;
 	}
 }
 
@@ -334,6 +371,7 @@ void MainSoftwareGUI::shutdown()
 	ImGui_ImplGlfw_Shutdown();
 	ImGui::DestroyContext();
 
+	ShaderLibrary::get().destroyAll();
 	glfwDestroyWindow(window);
 	glfwTerminate();
 }
@@ -303,6 +303,21 @@ void ObjectInspector::InspectTopology()
             ImGui::BulletText("Ngons: %zu", dna->getNgonCount());
             ImGui::BulletText("Edges: %zu", dna->getEdgeCount());
             ImGui::BulletText("Vertices: %zu", dna->getVerticeCount());
+
+            // the report walks every element's adjacency, only pay for it while expanded
+            if (ImGui::TreeNode("Element Memory"))
+            {
+                const Mesh::MemoryReport mem = mesh->getMemoryReport();
+                ImGui::BulletText("Vertices: %zu / %zu slots (%.1f KB)", mem.vertices.live, mem.vertices.capacity, mem.vertices.bytesReserved / 1024.0);
+                ImGui::BulletText("Edges: %zu / %zu slots (%.1f KB)", mem.edges.live, mem.edges.capacity, mem.edges.bytesReserved / 1024.0);
+                ImGui::BulletText("Faces: %zu / %zu slots (%.1f KB)", mem.faces.live, mem.faces.capacity, mem.faces.bytesReserved / 1024.0);
+                ImGui::BulletText("Adjacency lists: %.1f KB", mem.adjacencyBytes / 1024.0);
+                ImGui::BulletText("Side tables: %.1f KB", mem.attributeBytes / 1024.0);
+                if (mem.vertices.live > 0)
+                    ImGui::BulletText("Per vertex: %.1f B", double(mem.totalBytes()) / double(mem.vertices.live));
+                ImGui::BulletText("Vertex record: %zu B (target 16-32 B)", Mesh::kVertexRecordBytes);
+                ImGui::TreePop();
+            }
             ImGui::Separator();
         }
     }
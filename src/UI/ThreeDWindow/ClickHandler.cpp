@@ -73,7 +73,7 @@ void ClickHandler::handle()
                 // showErrorBox("ClickHandler:: Test ");
 
                 window->selector.pickUpMesh((int)relativeMouseX, (int)relativeMouseY,
-                windowWidth, windowHeight, window->view, window->proj, objects);
+                windowWidth, windowHeight, window->view, window->proj);
             }
 
             ThreeDObject* selected = window->selector.getSelectedObject();
@@ -118,6 +118,7 @@ void ThreeDWindow::threeDRendering()
     ImTextureID textureID = (ImTextureID)(intptr_t)scene->getTexture();
 
     ImGui::Image(textureID, oglChildSize, ImVec2(0, 1), ImVec2(1, 0));
+    updateHover(ImGui::IsItemHovered());
 
     ThreeDWorldInteractions();
 
@@ -185,6 +186,54 @@ void ThreeDWindow::threeDRendering()
 
 }
 
+// ---- hover highlight ---- //
+// In element modes the element under the cursor is found with the GPU pick
+// pass and flagged in its mesh's state buffer (one byte patch per change).
+
+void ThreeDWindow::updateHover(bool imageHovered)
+{
+    PickTarget target = hoveredTarget;
+    bool elementMode = true;
+    if (currentMode == &verticeMode)   target = PickTarget::Vertice;
+    else if (currentMode == &edgeMode) target = PickTarget::Edge;
+    else if (currentMode == &faceMode) target = PickTarget::Face;
+    else elementMode = false;
+
+    const ImGuiIO& io = ImGui::GetIO();
+    const bool mouseMoved = io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f;
+
+    if (elementMode && imageHovered && !mouseMoved && hoveredTarget == target)
+        return;
+
+    Mesh* newMesh = nullptr;
+    uint32_t newIndex = UINT32_MAX;
+
+    if (elementMode && imageHovered && !ImGuizmo::IsUsing())
+    {
+        ImVec2 mouse = ImGui::GetMousePos();
+        const int x = static_cast<int>(mouse.x - oglChildPos.x);
+        const int y = static_cast<int>(oglChildSize.y - (mouse.y - oglChildPos.y));
+
+        PickHit hit;
+        if (scene->pickElement(target, x, y, static_cast<int>(oglChildSize.x), static_cast<int>(oglChildSize.y), hit))
+        {
+            newMesh = hit.mesh;
+            newIndex = hit.elementIndex;
+        }
+    }
+
+    // the previous mesh may have been deleted since the last frame
+    if (hoveredMesh && (hoveredMesh != newMesh || hoveredTarget != target) && scene->containsObject(hoveredMesh))
+        hoveredMesh->setHoveredElement(hoveredTarget, UINT32_MAX);
+
+    if (newMesh)
+        newMesh->setHoveredElement(target, newIndex);
+
+    hoveredMesh = newMesh;
+    if (elementMode)
+        hoveredTarget = target;
+}
+
 void ThreeDWindow::renderModelingModes()
 {
     ImGui::SetCursorScreenPos(ImVec2(oglChildPos.x + 10, oglChildPos.y + 10));
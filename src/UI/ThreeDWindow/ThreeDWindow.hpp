@@ -41,6 +41,7 @@ class ThreeDObject;
 class ClickHandler;
 class ThreeDScene;
 class MainSoftwareGUI;
+class Mesh;
 
 //=== Class ===//
 class ThreeDWindow : public GUIWindow
@@ -75,7 +76,7 @@ public:
 
     void setMultipleSelectedObjects(const std::list<ThreeDObject*>& objects);
 
-    void setThreeDScene(ThreeDScene* s) { this->scene = s; }
+    void setThreeDScene(ThreeDScene* s) { this->scene = s; selector.setPickScene(s); }
     ThreeDScene* getThreeDScene() const { return scene; }
 
     void setMainGUI(MainSoftwareGUI* gui);
@@ -109,6 +110,7 @@ public:
     bool lastKeyState_3 = false;
     bool lastKeyState_4 = false;
     bool isEdgeLoopActive = false;
+    int edgeLoopCuts = 1;  // parallel loops per cut, set from EdgeLoopControl
 
     bool hasSelectedFace() const { return !multipleSelectedFaces.empty(); }
     void clearSelectedFaces();
@@ -121,6 +123,7 @@ private:
 
 
     void ThreeDWorldInteractions();
+    void updateHover(bool imageHovered);
     
 
     glm::mat4 view = glm::mat4(1.0f);
@@ -133,6 +136,8 @@ private:
     // std::vector<ThreeDObject *> ThreeDObjectsList;
     std::set<ThreeDObject *> lastSelection;
     Vertice* lastSelectedVertice = nullptr;
+    Mesh* hoveredMesh = nullptr;
+    PickTarget hoveredTarget = PickTarget::Vertice;
     ImGuizmo::OPERATION currentGizmoOperation = ImGuizmo::TRANSLATE;
     
     MainSoftwareGUI* mainGUI = nullptr;
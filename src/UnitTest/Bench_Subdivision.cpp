@@ -0,0 +1,94 @@
+// src/UnitTest/Bench_Subdivision.cpp
+// Two Catmull-Clark levels over a 100k-quad torus, timed from one thread up
+// to every hardware thread. Build it like any test : run test Bench_Subdivision.cpp
+#include <gtest/gtest.h>
+
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include "WorldObjects/Mesh/MeshSubdivision.hpp"
+#include "Engine/MeshEdit/Subdivide.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+static void buildTorus(Mesh& mesh, int around, int across)
+{
+    std::vector<Vertice*> v;
+    v.reserve(size_t(around) * across);
+    for (int i = 0; i < around; ++i)
+    {
+        const float a = 6.2831853f * i / around;
+        for (int j = 0; j < across; ++j)
+        {
+            const float b = 6.2831853f * j / across;
+            const float r = 3.0f + std::cos(b);
+            v.push_back(mesh.addVertice({ r * std::cos(a), std::sin(b), r * std::sin(a) }));
+        }
+    }
+    auto at = [&](int i, int j) { return v[size_t(i % around) * across + (j % across)]; };
+
+    // ring i owns the edge running along it and the one towards ring i + 1
+    std::vector<Edge*> along, towards;
+    for (int i = 0; i < around; ++i)
+        for (int j = 0; j < across; ++j)
+        {
+            along.push_back(mesh.addEdge(at(i, j), at(i, j + 1)));
+            towards.push_back(mesh.addEdge(at(i, j), at(i + 1, j)));
+        }
+    auto alongEdge = [&](int i, int j) { return along[size_t(i % around) * across + (j % across)]; };
+    auto towardsEdge = [&](int i, int j) { return towards[size_t(i % around) * across + (j % across)]; };
+
+    for (int i = 0; i < around; ++i)
+        for (int j = 0; j < across; ++j)
+            mesh.addQuad({ at(i, j), at(i + 1, j), at(i + 1, j + 1), at(i, j + 1) },
+                { towardsEdge(i, j), alongEdge(i + 1, j), towardsEdge(i, j + 1), alongEdge(i, j) });
+}
+
+template <typename Fn>
+static double millis(const Fn& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+TEST(BenchSubdivision, TwoLevelsThreadScaling)
+{
+    Mesh mesh;
+    buildTorus(mesh, 400, 250);
+    ASSERT_EQ(mesh.faceCount(), 100000u);
+    const MeshTopology& topo = mesh.getTopology();
+
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < hardware; t *= 2) counts.push_back(t);
+    counts.push_back(hardware);
+
+    MeshSubdivision::Cage reference;
+    double single = 0.0;
+    for (unsigned threads : counts)
+    {
+        MeshSubdivision::Cage cage;
+        const double ms = millis([&] { cage = MeshSubdivision::subdivide(topo, 2, threads); });
+        if (threads == 1)
+        {
+            single = ms;
+            reference = std::move(cage);
+        }
+        else
+        {
+            // every output is written by exactly one worker, so results match bit for bit
+            EXPECT_EQ(cage.points, reference.points);
+            EXPECT_EQ(cage.corners, reference.corners);
+            EXPECT_EQ(cage.edgeFaces, reference.edgeFaces);
+        }
+        std::printf("[bench] subdivide x2, %2u thread(s) : %8.1f ms  (x%.2f)\n", threads, ms, single / ms);
+    }
+    EXPECT_EQ(reference.faceCount(), 1600000u);
+
+    const double apply = millis([&] { MeshEdit::Subdivide(&mesh, 2); });
+    std::printf("[bench] Subdivide x2 applied to the mesh : %8.1f ms\n", apply);
+    EXPECT_EQ(mesh.faceCount(), 1600000u);
+}
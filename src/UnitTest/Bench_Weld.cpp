@@ -0,0 +1,108 @@
+// src/UnitTest/Bench_Weld.cpp
+// Weld by distance over a million vertices : once over a shared grid, where
+// nothing merges and only the clustering runs, then over the same grid split
+// into quads that own their corners, where the graph update runs as well.
+// Build it like any test : run test Bench_Weld.cpp
+#include <gtest/gtest.h>
+
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include "WorldObjects/Mesh_DNA/Mesh_DNA.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// (n + 1)^2 vertices shared by n x n quads
+static void buildSharedGrid(Mesh& mesh, int n)
+{
+    const int side = n + 1;
+    std::vector<Vertice*> v;
+    v.reserve(size_t(side) * side);
+    for (int i = 0; i < side; ++i)
+        for (int j = 0; j < side; ++j)
+            v.push_back(mesh.addVertice({ float(j), float(i), 0.0f }));
+    auto at = [&](int i, int j) { return v[size_t(i) * side + j]; };
+
+    // row i owns the edge running along it and the one towards row i + 1
+    std::vector<Edge*> along(size_t(side) * side, nullptr), towards(size_t(side) * side, nullptr);
+    for (int i = 0; i < side; ++i)
+        for (int j = 0; j < side; ++j)
+        {
+            if (j + 1 < side) along[size_t(i) * side + j] = mesh.addEdge(at(i, j), at(i, j + 1));
+            if (i + 1 < side) towards[size_t(i) * side + j] = mesh.addEdge(at(i, j), at(i + 1, j));
+        }
+
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            mesh.addQuad({ at(i, j), at(i, j + 1), at(i + 1, j + 1), at(i + 1, j) },
+                { along[size_t(i) * side + j], towards[size_t(i) * side + j + 1],
+                  along[size_t(i + 1) * side + j], towards[size_t(i) * side + j] });
+}
+
+// n x n quads, each with its own four corners and four sides
+static void buildQuadSoup(Mesh& mesh, int n)
+{
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+        {
+            const std::array<Vertice*, 4> q = {
+                mesh.addVertice({ float(j), float(i), 0.0f }),
+                mesh.addVertice({ float(j + 1), float(i), 0.0f }),
+                mesh.addVertice({ float(j + 1), float(i + 1), 0.0f }),
+                mesh.addVertice({ float(j), float(i + 1), 0.0f }) };
+            mesh.addQuad(q, { mesh.addEdge(q[0], q[1]), mesh.addEdge(q[1], q[2]),
+                              mesh.addEdge(q[2], q[3]), mesh.addEdge(q[3], q[0]) });
+        }
+}
+
+template <typename Fn>
+static double millis(const Fn& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// each case runs three times and reports its best, other load only adds to a run
+TEST(BenchWeld, MillionVertices)
+{
+    const float tolerance = 1e-3f;
+    const int runs = 3;
+
+    Mesh shared;
+    buildSharedGrid(shared, 999);
+    ASSERT_EQ(shared.vertexCount(), 1000000u);
+    double clustering = 1e30;
+    for (int run = 0; run < runs; ++run)
+    {
+        size_t merged = 1;
+        clustering = std::min(clustering, millis([&] { merged = shared.weldByDistance(tolerance); }));
+        EXPECT_EQ(merged, 0u);
+    }
+    std::printf("[bench] weld, 1M shared vertices, nothing merges : %8.1f ms\n", clustering);
+
+    // the editor's meshes carry a history, so the edit is journaled there too
+    for (const bool journaled : { false, true })
+    {
+        double total = 1e30;
+        for (int run = 0; run < runs; ++run)
+        {
+            Mesh soup;
+            if (journaled)
+                soup.setMeshDNA(new MeshDNA(), true);
+            buildQuadSoup(soup, 500);
+            ASSERT_EQ(soup.vertexCount(), 1000000u);
+
+            size_t merged = 0;
+            total = std::min(total, millis([&] { merged = soup.weldByDistance(tolerance); }));
+            EXPECT_EQ(merged, 1000000u - 501u * 501u);
+            EXPECT_EQ(soup.vertexCount(), 501u * 501u);
+            EXPECT_EQ(soup.edgeCount(), 2u * 500u * 501u);
+            EXPECT_EQ(soup.faceCount(), 250000u);
+        }
+        std::printf("[bench] weld, 1M vertices into 251k%s : %8.1f ms  (graph update ~%.1f ms)\n",
+            journaled ? ", journaled" : "", total, total - clustering);
+    }
+}
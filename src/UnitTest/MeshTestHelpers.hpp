@@ -0,0 +1,122 @@
+// src/UnitTest/MeshTestHelpers.hpp
+// Shared fixture for the mesh suites : a mesh that owns its DNA, plus the
+// small builders most tests start from.
+#pragma once
+#include <gtest/gtest.h>
+
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include "WorldObjects/Mesh_DNA/Mesh_DNA.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <tuple>
+
+class MeshTest : public ::testing::Test
+{
+protected:
+    struct Grid
+    {
+        int width = 0;
+        std::vector<Vertice*> vertices; // width + 1 per row
+        std::vector<Face*> faces;       // width per row
+
+        Vertice* at(int x, int y) const { return vertices[y * (width + 1) + x]; }
+        Face* face(int x, int y) const { return faces[y * width + x]; }
+    };
+
+    MeshTest() : dna(new MeshDNA())
+    {
+        mesh.setMeshDNA(dna, true);
+    }
+
+    // the existing edge between a and b, or a new one listed on both
+    Edge* edge(Vertice* a, Vertice* b)
+    {
+        if (Edge* e = mesh.findEdge(a, b)) return e;
+        Edge* e = mesh.addEdge(a, b);
+        a->addEdge(e);
+        b->addEdge(e);
+        return e;
+    }
+
+    // width x height unit quads in the z = 0 plane, corners counter-clockwise
+    Grid makeGrid(int width, int height)
+    {
+        Grid grid;
+        grid.width = width;
+        for (int y = 0; y <= height; ++y)
+            for (int x = 0; x <= width; ++x)
+                grid.vertices.push_back(mesh.addVertice({ float(x), float(y), 0 }));
+
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+            {
+                Vertice* q[4] = { grid.at(x, y), grid.at(x + 1, y), grid.at(x + 1, y + 1), grid.at(x, y + 1) };
+                grid.faces.push_back(mesh.addQuad({ q[0], q[1], q[2], q[3] },
+                    { edge(q[0], q[1]), edge(q[1], q[2]), edge(q[2], q[3]), edge(q[3], q[0]) }));
+            }
+        return grid;
+    }
+
+    // the mesh by positions only, so an element rebuilt by a rewind matches the
+    // one it stands for : faces from their smallest corner on, edges with the
+    // faces they border, vertices with their edge and face counts, all sorted
+    using Shape = std::vector<std::vector<float>>;
+    Shape shape() const
+    {
+        auto before = [](const Vertice* a, const Vertice* b)
+        {
+            const glm::vec3 p = a->getLocalPosition(), q = b->getLocalPosition();
+            return std::tie(p.x, p.y, p.z) < std::tie(q.x, q.y, q.z);
+        };
+        auto put = [](std::vector<float>& entry, const Vertice* v)
+        {
+            const glm::vec3 p = v->getLocalPosition();
+            entry.insert(entry.end(), { p.x, p.y, p.z });
+        };
+
+        Shape s;
+        for (const Face* f : mesh.getFaces())
+        {
+            const auto& vs = f->getVertices();
+            const auto& es = f->getEdges();
+            size_t lo = 0;
+            for (size_t i = 1; i < vs.size(); ++i)
+                if (before(vs[i], vs[lo])) lo = i;
+
+            // 1 when every side runs between the corners it sits between
+            bool sided = es.size() == vs.size();
+            for (size_t i = 0; i < vs.size() && sided; ++i)
+            {
+                const Edge* e = es[i];
+                const Vertice* a = vs[i];
+                const Vertice* b = vs[(i + 1) % vs.size()];
+                sided = e && ((e->getStart() == a && e->getEnd() == b) || (e->getStart() == b && e->getEnd() == a));
+            }
+
+            std::vector<float> entry{ 0.0f, sided ? 1.0f : 0.0f };
+            for (size_t i = 0; i < vs.size(); ++i)
+                put(entry, vs[(lo + i) % vs.size()]);
+            s.push_back(entry);
+        }
+        for (const Edge* e : mesh.getEdges())
+        {
+            std::vector<float> entry{ 1.0f, float(e->getSharedFaces().size()) };
+            const bool flip = before(e->getEnd(), e->getStart());
+            put(entry, flip ? e->getEnd() : e->getStart());
+            put(entry, flip ? e->getStart() : e->getEnd());
+            s.push_back(entry);
+        }
+        for (const Vertice* v : mesh.getVertices())
+        {
+            std::vector<float> entry{ 2.0f, float(v->getEdges().size()), float(v->getFaces().size()) };
+            put(entry, v);
+            s.push_back(entry);
+        }
+        std::sort(s.begin(), s.end());
+        return s;
+    }
+
+    MeshDNA* dna;   // owned by mesh
+    Mesh mesh;
+};
@@ -0,0 +1,202 @@
+// src/UnitTest/Test_GpuPick.cpp
+// GpuPicker on a real GL context : a hidden GLFW window, or GLFW's null
+// platform over surfaceless EGL when there is no display to open one on.
+#include <gtest/gtest.h>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "Engine/GpuPicker.hpp"
+#include "Engine/OpenGLContext.hpp"
+#include "Engine/ShaderLibrary.hpp"
+#include "WorldObjects/Mesh/Mesh.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <array>
+#include <memory>
+
+namespace
+{
+    constexpr int kSize = 64; // framebuffer and viewport, in pixels
+
+    GLFWwindow* openHiddenWindow()
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        return glfwCreateWindow(kSize, kSize, "GpuPick", nullptr, nullptr);
+    }
+}
+
+class GpuPick : public ::testing::Test
+{
+protected:
+    // one axis-aligned quad per mesh, facing the camera
+    struct Plate
+    {
+        std::unique_ptr<Mesh> mesh;
+        std::array<Vertice*, 4> corners{}; // counter-clockwise from (lo.x, lo.y)
+        std::array<Edge*, 4> sides{};      // bottom, right, top, left
+        Face* face = nullptr;
+    };
+
+    static void SetUpTestSuite()
+    {
+        if (glfwInit())
+            window = openHiddenWindow();
+
+        if (!window)
+        {
+            glfwTerminate();
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+            if (glfwInit())
+            {
+                glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+                window = openHiddenWindow();
+            }
+        }
+
+        if (!window) return;
+        glfwMakeContextCurrent(window);
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+        {
+            glfwDestroyWindow(window);
+            window = nullptr;
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        if (window)
+        {
+            ShaderLibrary::get().destroyAll();
+            glfwDestroyWindow(window);
+            window = nullptr;
+        }
+        glfwTerminate();
+    }
+
+    void SetUp() override
+    {
+        if (!window)
+            GTEST_SKIP() << "no OpenGL 3.3 context available";
+
+        context = std::make_unique<OpenGLContext>();
+        context->resize(kSize, kSize);
+
+        // the camera looks down -z; ortho keeps world xy equal to NDC
+        view = glm::lookAt(glm::vec3(0, 0, 5), glm::vec3(0), glm::vec3(0, 1, 0));
+        projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, 0.1f, 10.0f);
+
+        // front covers pixels 16..48, back 3..35 : back's upper-right corner is hidden
+        front = makePlate({ -0.5f, -0.5f }, { 0.5f, 0.5f }, 0.0f);
+        back = makePlate({ -0.9f, -0.9f }, { 0.1f, 0.1f }, -1.0f);
+        objects = { front.mesh.get(), back.mesh.get() };
+    }
+
+    void TearDown() override
+    {
+        // GL buffers go while the context is still current
+        front.mesh.reset();
+        back.mesh.reset();
+        context.reset();
+    }
+
+    Plate makePlate(glm::vec2 lo, glm::vec2 hi, float z)
+    {
+        Plate plate;
+        plate.mesh = std::make_unique<Mesh>();
+        Mesh& mesh = *plate.mesh;
+
+        plate.corners = { mesh.addVertice({ lo.x, lo.y, z }), mesh.addVertice({ hi.x, lo.y, z }),
+            mesh.addVertice({ hi.x, hi.y, z }), mesh.addVertice({ lo.x, hi.y, z }) };
+        for (int i = 0; i < 4; ++i)
+            plate.sides[i] = mesh.addEdge(plate.corners[i], plate.corners[(i + 1) % 4]);
+        plate.face = mesh.addQuad(plate.corners, plate.sides);
+        return plate;
+    }
+
+    PickHit pickAt(PickTarget target, int x, int y)
+    {
+        PickHit hit;
+        EXPECT_TRUE(picker.pick(*context, objects, view, projection, target, x, y, kSize, kSize, hit));
+        EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+        return hit;
+    }
+
+    static GLFWwindow* window;
+
+    std::unique_ptr<OpenGLContext> context;
+    GpuPicker picker;
+    std::list<ThreeDObject*> objects;
+    glm::mat4 view{ 1.0f };
+    glm::mat4 projection{ 1.0f };
+    Plate front, back;
+};
+
+GLFWwindow* GpuPick::window = nullptr;
+
+TEST_F(GpuPick, VertexWithinRadius)
+{
+    // two pixels off the corner at (16, 16), inside the vertex slack
+    PickHit hit = pickAt(PickTarget::Vertice, 18, 17);
+    EXPECT_EQ(hit.mesh, front.mesh.get());
+    EXPECT_EQ(hit.vertice, front.corners[0]);
+
+    hit = pickAt(PickTarget::Vertice, 5, 4);
+    EXPECT_EQ(hit.mesh, back.mesh.get());
+    EXPECT_EQ(hit.vertice, back.corners[0]);
+    EXPECT_EQ(hit.edge, nullptr);
+    EXPECT_EQ(hit.face, nullptr);
+}
+
+TEST_F(GpuPick, VertexBehindAFaceIsNotPicked)
+{
+    // back's corner at (35, 35) sits under front's face
+    const PickHit hit = pickAt(PickTarget::Vertice, 35, 35);
+    EXPECT_EQ(hit.mesh, nullptr);
+    EXPECT_EQ(hit.vertice, nullptr);
+}
+
+TEST_F(GpuPick, EdgeWithinRadius)
+{
+    PickHit hit = pickAt(PickTarget::Edge, 40, 18);
+    EXPECT_EQ(hit.mesh, front.mesh.get());
+    EXPECT_EQ(hit.edge, front.sides[0]);
+
+    // back's right side is only visible below front
+    hit = pickAt(PickTarget::Edge, 33, 10);
+    EXPECT_EQ(hit.mesh, back.mesh.get());
+    EXPECT_EQ(hit.edge, back.sides[1]);
+
+    hit = pickAt(PickTarget::Edge, 33, 28);
+    EXPECT_EQ(hit.mesh, nullptr);
+    EXPECT_EQ(hit.edge, nullptr);
+}
+
+TEST_F(GpuPick, FrontFaceWins)
+{
+    // both plates cover the centre
+    PickHit hit = pickAt(PickTarget::Face, 32, 32);
+    EXPECT_EQ(hit.mesh, front.mesh.get());
+    EXPECT_EQ(hit.face, front.face);
+
+    hit = pickAt(PickTarget::Face, 8, 8);
+    EXPECT_EQ(hit.mesh, back.mesh.get());
+    EXPECT_EQ(hit.face, back.face);
+
+    hit = pickAt(PickTarget::Face, 60, 60);
+    EXPECT_EQ(hit.mesh, nullptr);
+    EXPECT_EQ(hit.face, nullptr);
+}
+
+TEST_F(GpuPick, LeavesBlendStateAsFound)
+{
+    glDisable(GL_BLEND);
+    pickAt(PickTarget::Face, 32, 32);
+    EXPECT_FALSE(glIsEnabled(GL_BLEND));
+
+    glEnable(GL_BLEND);
+    pickAt(PickTarget::Face, 32, 32);
+    EXPECT_TRUE(glIsEnabled(GL_BLEND));
+}
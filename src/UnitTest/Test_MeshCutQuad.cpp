@@ -0,0 +1,82 @@
+// src/UnitTest/Test_MeshCutQuad.cpp
+#include "MeshTestHelpers.hpp"
+#include "Engine/MeshEdit/CutQuad.hpp"
+
+#include <cmath>
+
+class MeshCutQuad : public MeshTest
+{
+protected:
+    // open-ended tube of w quads : the ring through an axial edge goes all the way round
+    void makeTube(int w)
+    {
+        for (int i = 0; i < w; ++i)
+        {
+            const float a = 6.2831853f * i / w;
+            bottom.push_back(mesh.addVertice({std::cos(a), 0, std::sin(a)}));
+            top.push_back(mesh.addVertice({std::cos(a), 1, std::sin(a)}));
+        }
+        for (int i = 0; i < w; ++i)
+        {
+            const int j = (i + 1) % w;
+            mesh.addQuad({ bottom[i], bottom[j], top[j], top[i] },
+                { edge(bottom[i], bottom[j]), edge(bottom[j], top[j]), edge(top[j], top[i]), edge(top[i], bottom[i]) });
+        }
+    }
+
+    std::vector<Vertice*> bottom, top;
+};
+
+TEST_F(MeshCutQuad, MultiCutAcrossClosedRing)
+{
+    const int W = 8, cuts = 3;
+    makeTube(W);
+
+    const MeshLoops::Ring* ring = mesh.getEdgeRing(mesh.findEdge(bottom[0], top[0]));
+    ASSERT_NE(ring, nullptr);
+    ASSERT_EQ(ring->edges.size(), size_t(W));
+    ASSERT_EQ(ring->quads.size(), size_t(W));
+
+    const std::vector<Edge*> loop = ring->edges;
+    const std::vector<Quad*> quads = ring->quads;
+    const size_t historyBefore = dna->size();
+    MeshEdit::CutQuad(loop, &mesh, quads, cuts);
+
+    EXPECT_EQ(mesh.vertexCount(), size_t(2 * W + W * cuts));
+    EXPECT_EQ(mesh.edgeCount(), size_t(2 * W + W * (cuts + 1) + W * cuts));
+    EXPECT_EQ(mesh.faceCount(), size_t(W * (cuts + 1)));
+    EXPECT_EQ(dna->size(), historyBefore + 1);
+
+    // every inner edge is shared by exactly two of the new quads
+    for (Edge* e : mesh.getEdges())
+    {
+        const bool rim = e->getStart()->getLocalPosition().y == e->getEnd()->getLocalPosition().y
+            && (e->getStart()->getLocalPosition().y == 0.0f || e->getStart()->getLocalPosition().y == 1.0f);
+        EXPECT_EQ(e->getSharedFaces().size(), rim ? 1u : 2u);
+    }
+}
+
+TEST_F(MeshCutQuad, RewindRemovesTheCut)
+{
+    makeTube(6);
+    dna->ensureInit(mesh.getModelMatrix());
+    const Shape before = shape();
+    const size_t historyBefore = dna->size();
+
+    const MeshLoops::Ring* ring = mesh.getEdgeRing(mesh.findEdge(bottom[0], top[0]));
+    ASSERT_NE(ring, nullptr);
+    const std::vector<Edge*> loop = ring->edges;
+    const std::vector<Quad*> quads = ring->quads;
+    MeshEdit::CutQuad(loop, &mesh, quads, 2);
+    ASSERT_EQ(dna->size(), historyBefore + 1);
+    ASSERT_EQ(mesh.faceCount(), 18u);
+
+    dna->rewindComponentHistory(historyBefore - 1, &mesh);
+    EXPECT_EQ(dna->size(), historyBefore);
+    EXPECT_EQ(shape(), before);
+
+    // the rebuilt ring is a ring again
+    ring = mesh.getEdgeRing(mesh.findEdge(bottom[0], top[0]));
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(ring->quads.size(), 6u);
+}
@@ -0,0 +1,111 @@
+// src/UnitTest/Test_MeshEditTransaction.cpp
+#include "MeshTestHelpers.hpp"
+#include "Engine/MeshEdit/Subdivide.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using MeshEditTransaction = MeshTest;
+
+TEST_F(MeshEditTransaction, CommitRecordsOneTopologyEvent)
+{
+    const size_t before = dna->size();
+
+    mesh.beginEdit();
+    auto* v0 = mesh.addVertice({0,0,0}, "v0");
+    auto* v1 = mesh.addVertice({1,0,0}, "v1");
+    mesh.beginEdit();
+    mesh.addEdge(v0, v1);
+    mesh.commitEdit("inner");
+    EXPECT_TRUE(mesh.isEditing());
+    EXPECT_EQ(dna->size(), before);
+    mesh.commitEdit("scripted");
+
+    EXPECT_FALSE(mesh.isEditing());
+    ASSERT_EQ(dna->size(), before + 1);
+    const auto& ev = dna->getHistory().back();
+    EXPECT_EQ(ev.kind, ComponentEditKind::Topology);
+    EXPECT_EQ(ev.tag, "scripted");
+    EXPECT_EQ(ev.topology.verticeDelta, 2);
+    EXPECT_EQ(ev.topology.edgeDelta, 1);
+    EXPECT_EQ(ev.topology.faceDelta, 0);
+    EXPECT_EQ(dna->getVerticeCount(), 2u);
+    EXPECT_EQ(dna->getEdgeCount(), 1u);
+}
+
+TEST_F(MeshEditTransaction, RewindPutsBackWhatTheEditChanged)
+{
+    makeGrid(2, 1);
+    dna->ensureInit(mesh.getModelMatrix());
+    const Shape before = shape();
+    const size_t historyBefore = dna->size();
+
+    // adds a triangle on a new vertex, moves a corner and drops the middle edge's faces
+    mesh.beginEdit();
+    Vertice* apex = mesh.addVertice({ 1, 2, 0 });
+    Vertice* top = mesh.getVertices()[4];
+    Vertice* topRight = mesh.getVertices()[5];
+    mesh.addTriangle(top, topRight, apex, mesh.findEdge(top, topRight), mesh.addEdge(topRight, apex), mesh.addEdge(apex, top));
+    mesh.getVertices()[0]->setLocalPosition({ -1, -1, 0 });
+    mesh.destroySelectedFaces({ mesh.getFaces()[0] });
+    mesh.commitEdit("scripted");
+    ASSERT_EQ(dna->size(), historyBefore + 1);
+    ASSERT_NE(shape(), before);
+
+    dna->rewindComponentHistory(historyBefore - 1, &mesh);
+    EXPECT_EQ(dna->size(), historyBefore);
+    EXPECT_EQ(shape(), before);
+    EXPECT_FALSE(mesh.isEditing());
+}
+
+// the calls HistoryLogic makes when an earlier event is clicked
+static void rewindFromPanel(MeshDNA* dna, size_t index, Mesh* mesh)
+{
+    dna->rewindComponentHistory(index, mesh);
+    dna->rewindToAndApply(index, mesh);
+}
+
+TEST_F(MeshEditTransaction, PanelRewindsAMoveMadeBeforeASubdivision)
+{
+    const Grid grid = makeGrid(2, 2);
+    dna->ensureInit(mesh.getModelMatrix());
+    const Shape before = shape();
+    const size_t historyBefore = dna->size();
+
+    // the middle vertex lifted the way VerticeTransform records it, then the
+    // mesh subdivided : the move has to be undone after the subdivision
+    Vertice* middle = grid.at(1, 1);
+    middle->setLocalPosition({ 1, 1, 1 });
+    dna->trackVerticeModify(glm::translate(glm::mat4(1.0f), { 0, 0, 1 }), { middle }, &mesh);
+    MeshEdit::Subdivide(&mesh, 1);
+    ASSERT_EQ(dna->size(), historyBefore + 2);
+
+    rewindFromPanel(dna, historyBefore - 1, &mesh);
+    EXPECT_EQ(dna->size(), historyBefore);
+    EXPECT_FLOAT_EQ(middle->getLocalPosition().z, 0.0f);
+    EXPECT_EQ(shape(), before);
+}
+
+TEST_F(MeshEditTransaction, PanelRewindsAMoveOntoAWeldedVertex)
+{
+    // two quads with their own copy of the shared side, the right one lifted
+    Vertice* l[4] = { mesh.addVertice({0,0,0}), mesh.addVertice({1,0,0}), mesh.addVertice({1,1,0}), mesh.addVertice({0,1,0}) };
+    Vertice* r[4] = { mesh.addVertice({1,0,1}), mesh.addVertice({2,0,1}), mesh.addVertice({2,1,1}), mesh.addVertice({1,1,1}) };
+    for (Vertice** q : { l, r })
+        mesh.addQuad({ q[0], q[1], q[2], q[3] }, { edge(q[0], q[1]), edge(q[1], q[2]), edge(q[2], q[3]), edge(q[3], q[0]) });
+    dna->ensureInit(mesh.getModelMatrix());
+    const Shape before = shape();
+    const size_t historyBefore = dna->size();
+
+    // the right quad moved down onto the left one's side, then welded : the
+    // weld frees one of each coincident pair, the move still names them
+    std::vector<Vertice*> moved(r, r + 4);
+    for (Vertice* v : moved) v->setLocalPosition(v->getLocalPosition() - glm::vec3(0, 0, 1));
+    dna->trackVerticeModify(glm::translate(glm::mat4(1.0f), { 0, 0, -1 }), moved, &mesh);
+    ASSERT_EQ(mesh.weldByDistance(1e-3f), 2u);
+    ASSERT_EQ(dna->size(), historyBefore + 2);
+
+    rewindFromPanel(dna, historyBefore - 1, &mesh);
+    EXPECT_EQ(dna->size(), historyBefore);
+    EXPECT_EQ(mesh.vertexCount(), 8u);
+    EXPECT_EQ(shape(), before);
+}
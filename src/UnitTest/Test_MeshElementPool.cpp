@@ -0,0 +1,136 @@
+// src/UnitTest/Test_MeshElementPool.cpp
+#include <gtest/gtest.h>
+
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include "WorldObjects/Mesh/ElementPool.hpp"
+
+#include <vector>
+
+TEST(MeshElementPool, LiveSlotsAreDestroyedWithThePool)
+{
+    static int destroyed = 0;
+    destroyed = 0;
+    {
+        ElementPool pool(sizeof(int), alignof(int), [](void*) { ++destroyed; });
+        pool.allocate();
+        void* released = pool.allocate();
+        pool.allocate();
+        // the owner destroys what it releases itself
+        pool.release(released);
+    }
+    EXPECT_EQ(destroyed, 2);
+}
+
+TEST(MeshElementPool, SideTablesBelongToTheirMesh)
+{
+    Mesh mesh, other;
+    auto* v0 = mesh.addVertice({0,0,0}, "v0");
+    auto* v1 = mesh.addVertice({1,0,0});
+    auto* e0 = mesh.addEdge(v0, v1);
+    e0->setColor({1, 0, 0, 1});
+    other.addVertice({0,0,0});
+
+    EXPECT_EQ(mesh.attributes().vertexNames.size(), 1u);
+    EXPECT_EQ(mesh.attributes().edgeColors.size(), 1u);
+    // the other mesh only reports its own, empty tables
+    EXPECT_EQ(other.attributes().vertexNames.size(), 0u);
+    EXPECT_GT(mesh.getMemoryReport().attributeBytes, other.getMemoryReport().attributeBytes);
+
+    // a freed element leaves its entries, so a slot reused later starts clean
+    mesh.detachEdge(e0);
+    mesh.freeEdge(e0);
+    EXPECT_EQ(mesh.attributes().edgeColors.size(), 0u);
+}
+
+TEST(MeshElementPool, FindsTheSlabOfEverySlot)
+{
+    // enough slots for several slabs of growing size
+    ElementPool pool(sizeof(double), alignof(double));
+    std::vector<void*> slots;
+    for (int i = 0; i < 5000; ++i)
+        slots.push_back(pool.allocate());
+    ASSERT_GT(pool.stats().slabCount, 3u);
+
+    for (size_t i = 0; i < slots.size(); i += 2)
+        pool.release(slots[i]);
+
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+        ASSERT_TRUE(pool.owns(slots[i]));
+        EXPECT_EQ(pool.generationOf(slots[i]), i % 2 == 0 ? 2u : 1u);
+    }
+
+    // slot numbers are dense across the slabs, one per slot
+    std::vector<char> seen(pool.slotCount(), 0);
+    for (void* slot : slots)
+    {
+        const size_t index = pool.slotIndexOf(slot);
+        ASSERT_LT(index, seen.size());
+        EXPECT_EQ(seen[index]++, 0);
+    }
+
+    double outside = 0.0;
+    EXPECT_FALSE(pool.owns(&outside));
+    EXPECT_EQ(pool.generationOf(&outside), 0u);
+    EXPECT_EQ(pool.slotIndexOf(&outside), SIZE_MAX);
+}
+
+TEST(MeshElementPool, EdgeIndexFollowsDetachedEdges)
+{
+    // enough pairs for long probe runs, then every third edge leaves
+    Mesh mesh;
+    std::vector<Vertice*> v;
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(mesh.addVertice({ float(i), 0, 0 }));
+    std::vector<Edge*> e;
+    for (int i = 0; i + 2 < 1000; ++i)
+    {
+        e.push_back(mesh.addEdge(v[i], v[i + 1]));
+        e.push_back(mesh.addEdge(v[i + 2], v[i]));
+    }
+    for (size_t i = 0; i < e.size(); i += 3)
+        mesh.detachEdge(e[i]);
+
+    for (size_t i = 0; i < e.size(); ++i)
+    {
+        Edge* expected = i % 3 == 0 ? nullptr : e[i];
+        EXPECT_EQ(mesh.findEdge(e[i]->getStart(), e[i]->getEnd()), expected);
+        EXPECT_EQ(mesh.findEdge(e[i]->getEnd(), e[i]->getStart()), expected);
+    }
+    for (size_t i = 0; i < e.size(); i += 3)
+        mesh.freeEdge(e[i]);
+}
+
+TEST(MeshElementPool, AddEdgesFilesLikeAddEdge)
+{
+    // a batch on top of edges already filed, with a pair given twice
+    Mesh mesh;
+    std::vector<Vertice*> v;
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(mesh.addVertice({ float(i), 0, 0 }));
+    Edge* filed = mesh.addEdge(v[0], v[1]);
+
+    std::vector<Vertice*> ends;
+    for (int i = 0; i + 7 < 1000; ++i)
+        ends.insert(ends.end(), { v[i], v[i + 1], v[i + 7], v[i] });
+    ends.insert(ends.end(), { v[5], v[6] });
+    std::vector<Edge*> added;
+    mesh.addEdges(ends, added);
+    ASSERT_EQ(added.size(), ends.size() / 2);
+    EXPECT_EQ(mesh.edgeCount(), added.size() + 1);
+
+    // the first edge filed for a pair keeps it, whether it came alone or in the batch
+    EXPECT_EQ(mesh.findEdge(v[1], v[0]), filed);
+    EXPECT_EQ(mesh.findEdge(v[6], v[5]), added[10]);
+    for (size_t i = 1; i + 1 < added.size(); ++i)
+    {
+        EXPECT_EQ(added[i]->getStart(), ends[2 * i]);
+        EXPECT_EQ(mesh.findEdge(ends[2 * i + 1], ends[2 * i]), added[i]);
+    }
+
+    // list slots are right, detaching one leaves the rest filed
+    mesh.detachEdge(added[3]);
+    EXPECT_EQ(mesh.findEdge(ends[6], ends[7]), nullptr);
+    EXPECT_EQ(mesh.findEdge(ends[8], ends[9]), added[4]);
+    mesh.freeEdge(added[3]);
+}
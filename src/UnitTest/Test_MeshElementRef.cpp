@@ -0,0 +1,26 @@
+// src/UnitTest/Test_MeshElementRef.cpp
+#include <gtest/gtest.h>
+
+#include "WorldObjects/Mesh/Mesh.hpp"
+
+TEST(MeshElementRef, FreedSlotResolvesToNull)
+{
+    Mesh mesh;
+
+    auto* v0 = mesh.addVertice({0,0,0}, "v0");
+    auto* v1 = mesh.addVertice({1,0,0}, "v1");
+    auto* e0 = mesh.addEdge(v0, v1);
+
+    const ElementRef<Edge> ref = mesh.makeRef(e0);
+    EXPECT_EQ(mesh.resolve(ref), e0);
+
+    mesh.detachEdge(e0);
+    mesh.freeEdge(e0);
+    EXPECT_EQ(mesh.resolve(ref), nullptr);
+
+    // the slot is handed out again, the old ref must not pick up the new edge
+    auto* e1 = mesh.addEdge(v0, v1);
+    EXPECT_EQ(static_cast<Edge*>(e1), ref.get());
+    EXPECT_EQ(mesh.resolve(ref), nullptr);
+    EXPECT_EQ(mesh.resolve(mesh.makeRef(e1)), e1);
+}
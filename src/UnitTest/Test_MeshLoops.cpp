@@ -0,0 +1,28 @@
+// src/UnitTest/Test_MeshLoops.cpp
+#include "MeshTestHelpers.hpp"
+
+// MeshLoops itself is the class under test
+using MeshLoopsTest = MeshTest;
+
+TEST_F(MeshLoopsTest, RingAndLoopWalkPastOldStepCap)
+{
+    // 40 x 2 quad strip, longer than the 20 steps FindLoop used to stop at
+    const int W = 40, H = 2;
+    const Grid grid = makeGrid(W, H);
+    auto rowEdge = [&](int x, int y) { return mesh.findEdge(grid.at(x, y), grid.at(x + 1, y)); };
+    auto columnEdge = [&](int x, int y) { return mesh.findEdge(grid.at(x, y), grid.at(x, y + 1)); };
+
+    const MeshLoops::Ring* ring = mesh.getEdgeRing(columnEdge(10, 0));
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(ring->edges.size(), size_t(W + 1));
+    EXPECT_EQ(ring->quads.size(), size_t(W));
+    EXPECT_EQ(mesh.getEdgeRing(columnEdge(10, 0)), ring);
+
+    // the middle row runs through valence-4 vertices from border to border
+    const MeshLoops::Loop* loop = mesh.getEdgeLoop(rowEdge(10, 1));
+    ASSERT_NE(loop, nullptr);
+    EXPECT_FALSE(loop->closed);
+    ASSERT_EQ(loop->edges.size(), size_t(W));
+    EXPECT_TRUE((loop->edges.front() == rowEdge(0, 1) && loop->edges.back() == rowEdge(W - 1, 1))
+        || (loop->edges.front() == rowEdge(W - 1, 1) && loop->edges.back() == rowEdge(0, 1)));
+}
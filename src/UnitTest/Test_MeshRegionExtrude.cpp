@@ -0,0 +1,87 @@
+// src/UnitTest/Test_MeshRegionExtrude.cpp
+#include "MeshTestHelpers.hpp"
+
+#include <list>
+#include <algorithm>
+#include <cmath>
+
+namespace FaceTransform {
+    Face* extrudeSelectedFace(std::list<Face*>& selectedFaces, float distance);
+}
+
+using MeshRegionExtrude = MeshTest;
+
+TEST_F(MeshRegionExtrude, SplitsOnlyTheBoundary)
+{
+    // 4 x 4 grid, the middle 2 x 2 faces extruded together
+    const Grid grid = makeGrid(4, 4);
+    auto at = [&](int x, int y) { return grid.at(x, y); };
+    std::vector<Face*> region;
+    for (int y = 1; y <= 2; ++y)
+        for (int x = 1; x <= 2; ++x)
+            region.push_back(grid.face(x, y));
+    mesh.finalize();
+    ASSERT_EQ(mesh.vertexCount(), 25u);
+    ASSERT_EQ(mesh.edgeCount(), 40u);
+
+    const size_t historyBefore = dna->size();
+    std::list<Face*> selected(region.begin(), region.end());
+    const float dist = 0.5f;
+    ASSERT_NE(FaceTransform::extrudeSelectedFace(selected, dist), nullptr);
+    EXPECT_EQ(selected.size(), 4u);
+
+    // 8 boundary vertices split, the centre one moves; its 4 inner edges are rebuilt on the cap
+    EXPECT_EQ(mesh.vertexCount(), 25u + 8u);
+    EXPECT_EQ(mesh.edgeCount(), 40u + 8u + 12u - 4u);
+    EXPECT_EQ(mesh.faceCount(), 16u + 8u);
+    EXPECT_FLOAT_EQ(std::abs(at(2, 2)->getLocalPosition().z), dist);
+    EXPECT_EQ(at(1, 1)->getLocalPosition().z, 0.0f);
+
+    ASSERT_EQ(dna->size(), historyBefore + 1);
+    // copied : the rewind drops the event
+    const ExtrudeRecord rec = dna->getHistory().back().extrude;
+    EXPECT_EQ(rec.newVerts.size(), 8u);
+    EXPECT_EQ(rec.sideFaces.size(), 8u);
+    EXPECT_EQ(rec.capFaces.size(), 4u);
+    EXPECT_EQ(rec.oldSides.size(), 4u);
+
+    dna->rewindExtrudeHistory(historyBefore - 1, &mesh);
+    EXPECT_EQ(mesh.vertexCount(), 25u);
+    EXPECT_EQ(mesh.edgeCount(), 40u);
+    EXPECT_EQ(mesh.faceCount(), 16u);
+    EXPECT_FLOAT_EQ(at(2, 2)->getLocalPosition().z, 0.0f);
+
+    // everything the extrusion made went back to the pools
+    for (const auto& f : rec.sideFaces) EXPECT_EQ(mesh.resolve(f), nullptr);
+    for (const auto& f : rec.capFaces) EXPECT_EQ(mesh.resolve(f), nullptr);
+    for (const auto& e : rec.upEdges) EXPECT_EQ(mesh.resolve(e), nullptr);
+    for (const auto& v : rec.newVerts) EXPECT_EQ(mesh.resolve(v), nullptr);
+    for (Vertice* kept : mesh.getVertices())
+        for (Edge* e : kept->getEdges())
+            EXPECT_NE(std::find(mesh.getEdges().begin(), mesh.getEdges().end(), e), mesh.getEdges().end());
+}
+
+TEST_F(MeshRegionExtrude, RewindsFromTheHistoryPanel)
+{
+    const Grid grid = makeGrid(4, 4);
+    std::list<Face*> selected;
+    for (int y = 1; y <= 2; ++y)
+        for (int x = 1; x <= 2; ++x)
+            selected.push_back(grid.face(x, y));
+    mesh.finalize();
+
+    const size_t historyBefore = dna->size();
+    ASSERT_NE(FaceTransform::extrudeSelectedFace(selected, 0.5f), nullptr);
+    ASSERT_EQ(mesh.vertexCount(), 33u);
+
+    // the calls HistoryLogic makes when an earlier event is clicked
+    const size_t i = historyBefore - 1;
+    dna->rewindComponentHistory(i, &mesh);
+    dna->rewindToAndApply(i, &mesh);
+
+    EXPECT_EQ(mesh.vertexCount(), 25u);
+    EXPECT_EQ(mesh.edgeCount(), 40u);
+    EXPECT_EQ(mesh.faceCount(), 16u);
+    EXPECT_EQ(dna->size(), historyBefore);
+    EXPECT_FLOAT_EQ(grid.at(2, 2)->getLocalPosition().z, 0.0f);
+}
@@ -0,0 +1,58 @@
+// src/UnitTest/Test_MeshSubdivision.cpp
+#include "MeshTestHelpers.hpp"
+#include "Engine/MeshEdit/Subdivide.hpp"
+
+// MeshSubdivision itself is the class under test
+using MeshSubdivisionTest = MeshTest;
+
+TEST_F(MeshSubdivisionTest, CubePreviewAndApply)
+{
+    std::vector<Vertice*> v;
+    for (int i = 0; i < 8; ++i)
+        v.push_back(mesh.addVertice({ i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f }));
+    const int sides[6][4] = { {0,2,3,1}, {4,5,7,6}, {0,1,5,4}, {2,6,7,3}, {0,4,6,2}, {1,3,7,5} };
+    for (const auto& q : sides)
+        mesh.addQuad({ v[q[0]], v[q[1]], v[q[2]], v[q[3]] },
+            { edge(v[q[0]], v[q[1]]), edge(v[q[1]], v[q[2]]), edge(v[q[2]], v[q[3]]), edge(v[q[3]], v[q[0]]) });
+
+    const MeshSubdivision::Cage& preview = mesh.getSubdivisionPreview(1);
+    EXPECT_EQ(preview.vertexCount(), 26u);
+    EXPECT_EQ(preview.edgeCount(), 48u);
+    EXPECT_EQ(preview.faceCount(), 24u);
+    // a cube corner lands at 5/9 of the way out on every axis
+    for (int axis = 0; axis < 3; ++axis)
+        EXPECT_NEAR(preview.points[7][axis], 5.0f / 9.0f, 1e-5f);
+
+    // moving a vertex refreshes the cached preview
+    v[7]->setLocalPosition({2, 2, 2});
+    EXPECT_GT(mesh.getSubdivisionPreview(1).points[7].x, 5.0f / 9.0f + 1e-3f);
+    v[7]->setLocalPosition({1, 1, 1});
+    EXPECT_EQ(mesh.vertexCount(), 8u);
+
+    const size_t historyBefore = dna->size();
+    MeshEdit::Subdivide(&mesh, 2);
+    EXPECT_EQ(mesh.vertexCount(), 98u);
+    EXPECT_EQ(mesh.edgeCount(), 192u);
+    EXPECT_EQ(mesh.faceCount(), 96u);
+    EXPECT_EQ(dna->size(), historyBefore + 1);
+    for (Edge* e : mesh.getEdges())
+        EXPECT_EQ(e->getSharedFaces().size(), 2u);
+}
+
+TEST_F(MeshSubdivisionTest, RewindRestoresTheCage)
+{
+    makeGrid(3, 2);
+    mesh.getVertices()[5]->setLocalPosition({ 1, 1, 0.5f });
+    dna->ensureInit(mesh.getModelMatrix());
+    const Shape before = shape();
+    const size_t historyBefore = dna->size();
+
+    // the original vertices stay and move, every face and edge is replaced
+    MeshEdit::Subdivide(&mesh, 1);
+    ASSERT_EQ(mesh.faceCount(), 24u);
+    ASSERT_EQ(dna->size(), historyBefore + 1);
+
+    dna->rewindComponentHistory(historyBefore - 1, &mesh);
+    EXPECT_EQ(dna->size(), historyBefore);
+    EXPECT_EQ(shape(), before);
+}
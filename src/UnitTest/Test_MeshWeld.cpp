@@ -0,0 +1,190 @@
+// src/UnitTest/Test_MeshWeld.cpp
+#include "MeshTestHelpers.hpp"
+
+#include <array>
+#include <random>
+#include <set>
+#include <utility>
+
+using MeshWeld = MeshTest;
+
+TEST_F(MeshWeld, MergesCoincidentVerticesAndCollapsedFaces)
+{
+    // a cube whose six sides each carry their own four corners, slightly off
+    const int sides[6][4] = { {0,2,3,1}, {4,5,7,6}, {0,1,5,4}, {2,6,7,3}, {0,4,6,2}, {1,3,7,5} };
+    for (int s = 0; s < 6; ++s)
+    {
+        std::array<Vertice*, 4> q;
+        for (int k = 0; k < 4; ++k)
+        {
+            const int i = sides[s][k];
+            const float jitter = 1e-5f * static_cast<float>(s);
+            q[k] = mesh.addVertice({ (i & 1 ? 1.f : -1.f) + jitter, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f });
+        }
+        mesh.addQuad(q, { mesh.addEdge(q[0], q[1]), mesh.addEdge(q[1], q[2]), mesh.addEdge(q[2], q[3]), mesh.addEdge(q[3], q[0]) });
+    }
+
+    // a loose quad with two corners on top of each other collapses to a triangle
+    Vertice* s0 = mesh.addVertice({ 5, 0, 0 });
+    Vertice* s1 = mesh.addVertice({ 6, 0, 0 });
+    Vertice* s2 = mesh.addVertice({ 6, 1, 0 });
+    Vertice* s3 = mesh.addVertice({ 6, 1, 1e-4f });
+    mesh.addQuad({ s0, s1, s2, s3 }, { mesh.addEdge(s0, s1), mesh.addEdge(s1, s2), mesh.addEdge(s2, s3), mesh.addEdge(s3, s0) });
+    ASSERT_EQ(mesh.vertexCount(), 28u);
+
+    const size_t historyBefore = dna->size();
+    EXPECT_EQ(mesh.weldByDistance(1e-3f), 17u);
+    EXPECT_EQ(mesh.vertexCount(), 11u);
+    EXPECT_EQ(mesh.edgeCount(), 15u);
+    EXPECT_EQ(mesh.faceCount(), 7u);
+    EXPECT_EQ(dna->size(), historyBefore + 1);
+
+    size_t triangles = 0;
+    for (Face* f : mesh.getFaces())
+        triangles += f->getVertices().size() == 3;
+    EXPECT_EQ(triangles, 1u);
+    // the cube is closed again, only the triangle keeps open sides
+    size_t open = 0;
+    for (Edge* e : mesh.getEdges())
+    {
+        EXPECT_NE(e->getStart(), e->getEnd());
+        open += e->getSharedFaces().size() == 1;
+    }
+    EXPECT_EQ(open, 3u);
+    for (Vertice* v : mesh.getVertices())
+        EXPECT_EQ(v->getFaces().size(), v->getLocalPosition().x > 4.0f ? 1u : 3u);
+
+    // nothing left within reach
+    EXPECT_EQ(mesh.weldByDistance(1e-3f), 0u);
+    EXPECT_EQ(dna->size(), historyBefore + 1);
+}
+
+TEST_F(MeshWeld, RewindSplitsTheWeldedVerticesAgain)
+{
+    // two quads side by side, each with its own copy of the shared side,
+    // and a quad whose last corner sits on its first : it welds to a triangle
+    Vertice* l[4] = { mesh.addVertice({0,0,0}), mesh.addVertice({1,0,0}), mesh.addVertice({1,1,0}), mesh.addVertice({0,1,0}) };
+    Vertice* r[4] = { mesh.addVertice({1,0,0}), mesh.addVertice({2,0,0}), mesh.addVertice({2,1,0}), mesh.addVertice({1,1,0}) };
+    Vertice* t[4] = { mesh.addVertice({0,2,0}), mesh.addVertice({1,2,0}), mesh.addVertice({1,3,0}), mesh.addVertice({0,2,1e-4f}) };
+    for (Vertice** q : { l, r, t })
+        mesh.addQuad({ q[0], q[1], q[2], q[3] }, { edge(q[0], q[1]), edge(q[1], q[2]), edge(q[2], q[3]), edge(q[3], q[0]) });
+
+    dna->ensureInit(mesh.getModelMatrix());
+    const Shape before = shape();
+    const size_t historyBefore = dna->size();
+
+    ASSERT_EQ(mesh.weldByDistance(1e-3f), 3u);
+    ASSERT_EQ(mesh.vertexCount(), 9u);
+    ASSERT_EQ(dna->size(), historyBefore + 1);
+
+    dna->rewindComponentHistory(historyBefore - 1, &mesh);
+    EXPECT_EQ(dna->size(), historyBefore);
+    EXPECT_EQ(shape(), before);
+
+    // and welds the same way again
+    EXPECT_EQ(mesh.weldByDistance(1e-3f), 3u);
+    EXPECT_EQ(mesh.vertexCount(), 9u);
+}
+
+TEST_F(MeshWeld, LeavesTheTopologyHandlesAlone)
+{
+    makeGrid(3, 3);
+    const MeshTopology& topo = mesh.getTopology();
+    const uint64_t version = mesh.getTopologyVersion();
+
+    // nothing within reach : the half-edge view is not rebuilt, so its handles must hold
+    EXPECT_EQ(mesh.weldByDistance(1e-3f), 0u);
+    EXPECT_EQ(mesh.getTopologyVersion(), version);
+    for (uint32_t v = 0; v < topo.vertexCount(); ++v)
+        EXPECT_EQ(topo.handleOf(topo.vertice(v)), v);
+}
+
+TEST_F(MeshWeld, MatchesBruteForceOnRandomClouds)
+{
+    const float tolerance = 0.03f;
+    for (unsigned seed : { 1u, 2u, 3u })
+    {
+        mesh.destroy();
+        dna = new MeshDNA();
+        mesh.setMeshDNA(dna, true);
+
+        // dense enough for chains of merges, with some exact duplicates
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> coord(0.0f, 1.0f);
+        const int n = 1500;
+        std::vector<glm::vec3> points;
+        for (int i = 0; i < n; ++i)
+        {
+            if (i > 0 && rng() % 10 == 0)
+                points.push_back(points[rng() % points.size()]);
+            else
+                points.push_back({ coord(rng), coord(rng), coord(rng) });
+        }
+        std::vector<Vertice*> v;
+        for (const glm::vec3& p : points)
+            v.push_back(mesh.addVertice(p));
+
+        std::vector<std::array<int, 3>> triangles;
+        for (int t = 0; t < 2000; ++t)
+        {
+            const int a = rng() % n, b = rng() % n, c = rng() % n;
+            if (a == b || b == c || a == c) continue;
+            triangles.push_back({ a, b, c });
+            mesh.addTriangle(v[a], v[b], v[c], edge(v[a], v[b]), edge(v[b], v[c]), edge(v[c], v[a]));
+        }
+
+        // ---- every pair, joined transitively, the lowest index stays ---- //
+        std::vector<int> root(n);
+        for (int i = 0; i < n; ++i) root[i] = i;
+        auto find = [&](int i) { while (root[i] != i) i = root[i] = root[root[i]]; return i; };
+        for (int i = 0; i < n; ++i)
+            for (int j = i + 1; j < n; ++j)
+            {
+                const glm::vec3 d = points[i] - points[j];
+                if (glm::dot(d, d) > tolerance * tolerance) continue;
+                const int a = find(i), b = find(j);
+                if (a != b) root[std::max(a, b)] = std::min(a, b);
+            }
+
+        std::vector<glm::vec3> kept;
+        size_t merged = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            if (find(i) == i) kept.push_back(points[i]);
+            else ++merged;
+        }
+
+        std::set<std::pair<int, int>> pairs;
+        for (const Edge* e : mesh.getEdges())
+        {
+            int a = -1, b = -1;
+            for (int i = 0; i < n; ++i)
+            {
+                if (v[i] == e->getStart()) a = find(i);
+                if (v[i] == e->getEnd()) b = find(i);
+            }
+            if (a != b) pairs.insert({ std::min(a, b), std::max(a, b) });
+        }
+
+        size_t faces = 0;
+        for (const auto& t : triangles)
+        {
+            const int a = find(t[0]), b = find(t[1]), c = find(t[2]);
+            faces += a != b && b != c && a != c;
+        }
+
+        ASSERT_EQ(mesh.weldByDistance(tolerance), merged) << "seed " << seed;
+        std::vector<glm::vec3> survivors;
+        for (const Vertice* s : mesh.getVertices())
+            survivors.push_back(s->getLocalPosition());
+        EXPECT_EQ(survivors, kept) << "seed " << seed;
+        EXPECT_EQ(mesh.edgeCount(), pairs.size()) << "seed " << seed;
+        EXPECT_EQ(mesh.faceCount(), faces) << "seed " << seed;
+        for (const Face* f : mesh.getFaces())
+            for (const Edge* e : f->getEdges())
+            {
+                ASSERT_NE(e, nullptr);
+                EXPECT_NE(e->getStart(), e->getEnd());
+            }
+    }
+}
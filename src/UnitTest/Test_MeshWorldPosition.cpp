@@ -0,0 +1,38 @@
+// src/UnitTest/Test_MeshWorldPosition.cpp
+#include <gtest/gtest.h>
+
+#include "WorldObjects/Mesh/Mesh.hpp"
+
+TEST(MeshWorldPosition, FollowsModelMatrix)
+{
+    Mesh mesh;
+    auto* v0 = mesh.addVertice({1,0,0}, "v0");
+
+    // composes and caches the model matrix, the moves below must invalidate it
+    EXPECT_EQ(v0->getPosition(), glm::vec3(1,0,0));
+
+    const uint64_t topologyBefore = mesh.getTopologyVersion();
+    mesh.setPosition({0,0,5});
+    mesh.setScale({2,2,2});
+
+    // moving the object leaves vertices untouched, their world position is derived
+    EXPECT_EQ(mesh.getTopologyVersion(), topologyBefore);
+    EXPECT_EQ(v0->getLocalPosition(), glm::vec3(1,0,0));
+    EXPECT_EQ(v0->getPosition(), glm::vec3(2,0,5));
+}
+
+TEST(MeshWorldPosition, SetModelMatrixRecomposes)
+{
+    Mesh mesh;
+    auto* v0 = mesh.addVertice({0,1,0}, "v0");
+    EXPECT_EQ(v0->getPosition(), glm::vec3(0,1,0));
+
+    mesh.setModelMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(3,0,0)));
+    EXPECT_EQ(mesh.getPosition(), glm::vec3(3,0,0));
+    EXPECT_EQ(v0->getPosition(), glm::vec3(3,1,0));
+
+    mesh.setRotation({0,0,90});
+    const glm::vec3 p = v0->getPosition();
+    EXPECT_NEAR(p.x, 2.0f, 1e-5f);
+    EXPECT_NEAR(p.y, 0.0f, 1e-5f);
+}
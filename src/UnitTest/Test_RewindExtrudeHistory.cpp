@@ -19,12 +19,6 @@ namespace FaceTransform {
 static bool containsPtr(const std::vector<Vertice*>& vec, const Vertice* p) {
     return std::find(vec.begin(), vec.end(), p) != vec.end();
 }
-static bool containsPtr(const std::vector<Edge*>& vec, const Edge* p) {
-    return std::find(vec.begin(), vec.end(), p) != vec.end();
-}
-static bool containsPtr(const std::vector<Face*>& vec, const Face* p) {
-    return std::find(vec.begin(), vec.end(), p) != vec.end();
-}
 
 TEST(MeshExtrudeDNA, RewindExtrudeHistory_RestoresTopology)
 {
@@ -78,6 +72,13 @@ TEST(MeshExtrudeDNA, RewindExtrudeHistory_RestoresTopology)
     EXPECT_EQ(extr.tag, "extrude_face");
     EXPECT_EQ(extr.kind, ComponentEditKind::Extrude);
     EXPECT_FLOAT_EQ(extr.extrude.distance, dist);
+    ASSERT_EQ(extr.extrude.newVerts.size(),  4u);
+    ASSERT_EQ(extr.extrude.capEdges.size(),  4u);
+    ASSERT_EQ(extr.extrude.upEdges.size(),   4u);
+    ASSERT_EQ(extr.extrude.sideFaces.size(), 4u);
+    ASSERT_EQ(extr.extrude.oldVerts.size(),  4u);
+    ASSERT_EQ(extr.extrude.oldEdges.size(),  4u);
+    ASSERT_EQ(extr.extrude.capFaces.size(),  1u);
     for (int i = 0; i < 4; ++i) {
         EXPECT_NE(extr.extrude.newVerts[i],  nullptr);
         EXPECT_NE(extr.extrude.capEdges[i],  nullptr);
@@ -86,19 +87,20 @@ TEST(MeshExtrudeDNA, RewindExtrudeHistory_RestoresTopology)
         EXPECT_NE(extr.extrude.oldVerts[i],  nullptr);
         EXPECT_NE(extr.extrude.oldEdges[i],  nullptr);
     }
-    EXPECT_NE(extr.extrude.capFace, nullptr);
+    EXPECT_NE(extr.extrude.capFaces[0], nullptr);
 
-    std::unordered_set<Vertice*> createdVerts;
-    std::unordered_set<Edge*> createdEdges;
-    std::unordered_set<Face*> createdFaces;
+    // refs rather than pointers : the rewind frees these and may hand their slots out again
+    std::vector<ElementRef<Vertice>> createdVerts;
+    std::vector<ElementRef<Edge>> createdEdges;
+    std::vector<ElementRef<Face>> createdFaces;
 
     for (int i = 0; i < 4; ++i) {
-        createdVerts.insert(extr.extrude.newVerts[i]);
-        createdEdges.insert(extr.extrude.capEdges[i]);
-        createdEdges.insert(extr.extrude.upEdges[i]);
-        createdFaces.insert(extr.extrude.sideFaces[i]);
+        createdVerts.push_back(extr.extrude.newVerts[i]);
+        createdEdges.push_back(extr.extrude.capEdges[i]);
+        createdEdges.push_back(extr.extrude.upEdges[i]);
+        createdFaces.push_back(extr.extrude.sideFaces[i]);
     }
-    createdFaces.insert(extr.extrude.capFace);
+    createdFaces.push_back(extr.extrude.capFaces[0]);
 
 
     if (extrIndex > 0) {
@@ -110,13 +112,11 @@ TEST(MeshExtrudeDNA, RewindExtrudeHistory_RestoresTopology)
     EXPECT_EQ(mesh.vertexCount(), 4u);
     EXPECT_EQ(mesh.edgeCount(),   4u);
 
-    const auto& V = mesh.getVertices();
-    const auto& E = mesh.getEdges();
     const auto& F = mesh.getFaces();
 
-    for (auto* nv : createdVerts)  { EXPECT_FALSE(containsPtr(V, nv)) << "Dangling extruded vert still present"; }
-    for (auto* ne : createdEdges)  { EXPECT_FALSE(containsPtr(E, ne)) << "Dangling extruded edge still present"; }
-    for (auto* nf : createdFaces)  { EXPECT_FALSE(containsPtr(F, nf)) << "Dangling extruded face still present"; }
+    for (const auto& nv : createdVerts)  { EXPECT_EQ(mesh.resolve(nv), nullptr) << "Dangling extruded vert still present"; }
+    for (const auto& ne : createdEdges)  { EXPECT_EQ(mesh.resolve(ne), nullptr) << "Dangling extruded edge still present"; }
+    for (const auto& nf : createdFaces)  { EXPECT_EQ(mesh.resolve(nf), nullptr) << "Dangling extruded face still present"; }
 
 
     ASSERT_EQ(F.size(), 1u);
@@ -0,0 +1,74 @@
+// src/UnitTest/Test_SceneBVH.cpp
+#include <gtest/gtest.h>
+
+#include "Engine/SceneBVH.hpp"
+#include "WorldObjects/Mesh/Mesh.hpp"
+
+#include <memory>
+#include <vector>
+
+// a unit quad facing +z, centred on x
+static std::unique_ptr<Mesh> makePlate(float x)
+{
+    auto mesh = std::make_unique<Mesh>();
+    Vertice* v0 = mesh->addVertice({ -0.5f, -0.5f, 0 });
+    Vertice* v1 = mesh->addVertice({ 0.5f, -0.5f, 0 });
+    Vertice* v2 = mesh->addVertice({ 0.5f, 0.5f, 0 });
+    Vertice* v3 = mesh->addVertice({ -0.5f, 0.5f, 0 });
+    mesh->addQuad({ v0, v1, v2, v3 },
+        { mesh->addEdge(v0, v1), mesh->addEdge(v1, v2), mesh->addEdge(v2, v3), mesh->addEdge(v3, v0) });
+    mesh->setPosition({ x, 0, 0 });
+    return mesh;
+}
+
+static ThreeDObject* castAt(SceneBVH& bvh, float x)
+{
+    float distance = 0.0f;
+    bvh.update();
+    return bvh.raycast({ x, 0, 10 }, { 0, 0, -1 }, distance);
+}
+
+TEST(SceneBVH, OnlyMovedObjectsAreRefit)
+{
+    std::vector<std::unique_ptr<Mesh>> plates;
+    SceneBVH bvh;
+    for (int i = 0; i < 8; ++i)
+    {
+        plates.push_back(makePlate(2.0f * i));
+        bvh.insert(plates.back().get());
+    }
+    EXPECT_EQ(bvh.size(), 8u);
+    EXPECT_EQ(castAt(bvh, 6.0f), plates[3].get());
+    EXPECT_EQ(bvh.dirtyCount(), 0u);
+
+    plates[3]->setPosition({ 40, 0, 0 });
+    EXPECT_EQ(bvh.dirtyCount(), 1u);
+    EXPECT_EQ(castAt(bvh, 6.0f), nullptr);
+    EXPECT_EQ(castAt(bvh, 40.0f), plates[3].get());
+    EXPECT_EQ(bvh.dirtyCount(), 0u);
+}
+
+TEST(SceneBVH, RemovedAndDestroyedObjectsLeaveTheTree)
+{
+    SceneBVH bvh;
+    auto a = makePlate(0.0f);
+    auto b = makePlate(2.0f);
+    bvh.insert(a.get());
+    bvh.insert(b.get());
+
+    bvh.remove(a.get());
+    EXPECT_EQ(bvh.size(), 1u);
+    EXPECT_EQ(castAt(bvh, 0.0f), nullptr);
+    // no longer in the tree, its moves are not reported
+    a->setPosition({ 2, 0, 0 });
+    EXPECT_EQ(bvh.dirtyCount(), 0u);
+
+    b->setPosition({ 4, 0, 0 });
+    b.reset();
+    EXPECT_EQ(bvh.size(), 0u);
+    EXPECT_EQ(castAt(bvh, 4.0f), nullptr);
+
+    // and back in
+    bvh.insert(a.get());
+    EXPECT_EQ(castAt(bvh, 2.0f), a.get());
+}
@@ -18,40 +18,39 @@ Face* extrudeSelectedFace(std::list<Face*>& selectedFaces, float distance)
     auto* mesh = dynamic_cast<Mesh*>(owner);
     if (!mesh) return nullptr;
 
-    auto& V = const_cast<std::vector<Vertice*>&>(mesh->getVertices());
-    auto& E = const_cast<std::vector<Edge*>&>(mesh->getEdges());
-    auto& F = const_cast<std::vector<Face*>&>(mesh->getFaces());
-
-    const size_t facesBefore = F.size();
+    std::vector<Face*> region;
+    for (Face* f : selectedFaces) {
+        if (f && !f->getVertices().empty() && f->getVertices()[0]->getMeshParent() == owner)
+            region.push_back(f);
+    }
 
     MeshEdit::ExtrudeResult res{};
-    if (!MeshEdit::extrudeQuadFace(mesh, V, E, F, target, distance, &res))
+    if (!MeshEdit::extrudeRegion(mesh, region, distance, &res))
         return nullptr;
 
     if (auto* dna = mesh->getMeshDNA()) {
         ExtrudeRecord rec{};
-        for (int i = 0; i < 4; ++i) {
-            rec.newVerts[i] = res.newVerts[i];
-            rec.capEdges[i] = res.capEdges[i];
-            rec.upEdges[i] = res.upEdges[i];
-            rec.sideFaces[i] = res.sideFaces[i];
-            rec.oldVerts[i] = res.oldVerts[i];
-            rec.oldEdges[i] = res.oldEdges[i];
-        }
-        rec.capFace = res.capFace;
+        auto stamp = [&](const auto& from, auto& to) {
+            for (auto* element : from) to.push_back(mesh->makeRef(element));
+        };
+        stamp(res.newVerts, rec.newVerts);
+        stamp(res.capEdges, rec.capEdges);
+        stamp(res.upEdges, rec.upEdges);
+        stamp(res.sideFaces, rec.sideFaces);
+        stamp(res.capFaces, rec.capFaces);
+        stamp(res.movedVerts, rec.movedVerts);
+        stamp(res.oldVerts, rec.oldVerts);
+        stamp(res.oldEdges, rec.oldEdges);
+        rec.movedBy = res.movedBy;
+        rec.oldSides = res.oldSides;
         rec.distance = res.distance;
-        dna->trackExtrude(rec);
+        dna->trackExtrude(std::move(rec));
     }
 
-    if (F.size() <= facesBefore) return nullptr;
-    Face* newCap = F.back();
-    if (!newCap) return nullptr;
-
-
-    selectedFaces.clear();
-    selectedFaces.push_back(newCap);
+    if (res.capFaces.empty()) return nullptr;
 
-    return newCap;
+    selectedFaces.assign(res.capFaces.begin(), res.capFaces.end());
+    return res.capFaces.front();
 }
 
 }
@@ -0,0 +1,11 @@
+// src/UnitTest/shims/shim_engine_min.cpp
+// Errors go to the console instead of a Win32 message box.
+#include <string>
+#include <iostream>
+
+#include "Engine/ErrorBox.hpp"
+
+void showErrorBox(const std::string& message, const std::string& title)
+{
+    std::cerr << "[" << title << "] " << message << std::endl;
+}
@@ -2,51 +2,14 @@
 #include "WorldObjects/Basic/Vertice.hpp"
 #include "Engine/MeshEdit/CutQuad.hpp"
 #include "WorldObjects/Mesh/Mesh.hpp"
-#include <glad/glad.h>
-#include <glm/gtc/type_ptr.hpp>
 #include <iostream>
-#include <random>
-#include <sstream>
-#include <iostream>
-
-
-const char* edgeVertexShaderSrc = R"(
-#version 330 core
-layout(location = 0) in vec3 aPos;
-uniform mat4 viewProj;
-void main()
-{
-    gl_Position = viewProj * vec4(aPos, 1.0);
-}
-)";
+#include <algorithm>
 
-const char* edgeFragmentShaderSrc = R"(
-#version 330 core
-out vec4 FragColor;
-uniform vec4 color;
-void main()
-{
-    FragColor = color;
-}
-)";
 
 Edge::Edge(Vertice* start, Vertice* end)
     : v1(start), v2(end)
 {
-    id = generateEdgeID();
-}
-
-std::string Edge::generateEdgeID()
-{
-    static const char charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
-    static const size_t idLength = 12;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, sizeof(charset) - 2);
-    std::stringstream ss;
-    for (size_t i = 0; i < idLength; ++i)
-        ss << charset[dis(gen)];
-    return ss.str();
+    id = ElementID::next();
 }
 
 Edge::~Edge()
@@ -54,93 +17,72 @@ Edge::~Edge()
     destroy();
 }
 
-void Edge::compileShaders()
+void Edge::initialize()
 {
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &edgeVertexShaderSrc, nullptr);
-    glCompileShader(vertexShader);
+}
 
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &edgeFragmentShaderSrc, nullptr);
-    glCompileShader(fragmentShader);
+void Edge::destroy()
+{
+}
 
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+Vertice* Edge::getStart() const { return v1; }
+Vertice* Edge::getEnd() const { return v2; }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+void Edge::rewire(Vertice* start, Vertice* end)
+{
+    v1 = start;
+    v2 = end;
 }
 
-void Edge::initialize()
+// edges have no mesh pointer of their own; the start vertex knows it
+static Mesh* meshOf(const Vertice* start)
 {
-    compileShaders();
-
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
+    ThreeDObject* parent = start ? start->getMeshParent() : nullptr;
+    return parent && parent->getIsMesh() ? static_cast<Mesh*>(parent) : nullptr;
 }
 
-void Edge::render(const glm::mat4& viewProj, const glm::mat4& modelMatrix)
+static void notifyEdgeState(const Vertice* start, bool colorsChanged)
 {
-    if (!v1 || !v2) return;
-
-    glm::vec3 p1 = glm::vec3(modelMatrix * glm::vec4(v1->getLocalPosition(), 1.0f));
-    glm::vec3 p2 = glm::vec3(modelMatrix * glm::vec4(v2->getLocalPosition(), 1.0f));
-
-    float vertices[] = {
-        p1.x, p1.y, p1.z,
-        p2.x, p2.y, p2.z
-    };
-
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "viewProj"), 1, GL_FALSE, glm::value_ptr(viewProj));
-
+    if (Mesh* mesh = meshOf(start))
+        mesh->markElementStateDirty(PickTarget::Edge, colorsChanged);
+}
 
-   
-    glm::vec4 finalColor = edgeSelected
-        ? glm::vec4(1.0f, 0.5f, 0.0f, 1.0f)  
-        : color;                              
+void Edge::setSelected(bool isSelected)
+{
+    if (edgeSelected == isSelected)
+        return;
 
-    glUniform4fv(glGetUniformLocation(shaderProgram, "color"), 1, glm::value_ptr(finalColor));
+    edgeSelected = isSelected;
+    SceneRevision::bump();
+    notifyEdgeState(v1, false);
+}
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+bool Edge::isSelected() const { return edgeSelected; }
 
-    glLineWidth(2.0f);
-    glDrawArrays(GL_LINES, 0, 2);
-    glLineWidth(1.0f);
+// the color lives in the mesh's side table
+void Edge::setColor(const glm::vec4& c)
+{
+    Mesh* mesh = meshOf(v1);
+    if (!mesh)
+        return;
 
-    glBindVertexArray(0);
+    mesh->attributes().edgeColors.set(this, c);
+    SceneRevision::bump();
+    mesh->markElementStateDirty(PickTarget::Edge, true);
 }
-
-void Edge::destroy()
+glm::vec4 Edge::getColor() const
 {
-    if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
-    if (vbo) { glDeleteBuffers(1, &vbo); vbo = 0; }
-    if (shaderProgram) { glDeleteProgram(shaderProgram); shaderProgram = 0; }
+    const Mesh* mesh = meshOf(v1);
+    return (mesh ? mesh->attributes() : Mesh::defaultAttributes()).edgeColors.get(this);
 }
 
-Vertice* Edge::getStart() const { return v1; }
-Vertice* Edge::getEnd() const { return v2; }
-
-void Edge::setSelected(bool isSelected) { edgeSelected = isSelected; }
-bool Edge::isSelected() const { return edgeSelected; }
-
-void Edge::setColor(const glm::vec4& c) { color = c; }
-glm::vec4 Edge::getColor() const { return color; }
-
 
 void Edge::setSharedFaces(const std::vector<Face*>& faces)
 {
     sharedFaces = faces;
     for (const auto& f : faces)
     {
-        if (dynamic_cast<class Quad*>(f))
+        if (f && f->isQuad())
         {
             quadEdge = true;
             break;
@@ -155,6 +97,23 @@ const std::vector<Face*>& Edge::getSharedFaces() const
     return sharedFaces;
 }
 
+void Edge::addSharedFace(Face* f)
+{
+    if (!f || std::find(sharedFaces.begin(), sharedFaces.end(), f) != sharedFaces.end())
+        return;
+
+    sharedFaces.push_back(f);
+    if (f->isQuad())
+        quadEdge = true;
+}
+
+void Edge::removeSharedFace(Face* f)
+{
+    auto it = std::find(sharedFaces.begin(), sharedFaces.end(), f);
+    if (it != sharedFaces.end())
+        sharedFaces.erase(it);
+}
+
 std::vector<Vertice*> Edge::insertVerticesAlongEdge(int count, Mesh* parentMesh)
 {
     std::vector<Vertice*> newVertices;
@@ -178,7 +137,8 @@ void Edge::splitEdge(Vertice* newVertice, Mesh* parentMesh)
 
     Edge* e1 = parentMesh->addEdge(v1, newVertice);
     Edge* e2 = parentMesh->addEdge(newVertice, v2);
-    for (Face* f : parentMesh->getFaces())
+    // only the faces on this edge reference it, they move over to e1
+    for (Face* f : sharedFaces)
     {
         if (!f) continue;
         auto& faceEdges = f->getEdgesNonConst();
@@ -191,17 +151,14 @@ void Edge::splitEdge(Vertice* newVertice, Mesh* parentMesh)
             }
         
         }
+        e1->addSharedFace(f);
     }
+    sharedFaces.clear();
 
     e1->initialize();
     e2->initialize();
 
-    auto& meshEdges = parentMesh->getEdgesNonConst();
-    auto it = std::find(meshEdges.begin(), meshEdges.end(), this);
-    if (it != meshEdges.end())
-    {
-        meshEdges.erase(it);
-    }
+    parentMesh->detachEdge(this);
     
     this->destroy();
 }
\ No newline at end of file
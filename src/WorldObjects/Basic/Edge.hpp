@@ -1,9 +1,11 @@
 
 
 #pragma once
+#include "WorldObjects/Basic/ElementID.hpp"
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include <cstdint>
 
 // Forward declarations
 class Vertice;
@@ -15,14 +17,16 @@ public:
     Edge(Vertice* start, Vertice* end);
     ~Edge();
 
+    // GPU resources live in the parent mesh's MeshRenderCache
     void initialize();
-    void render(const glm::mat4& viewProj, const glm::mat4& modelMatrix);
     void destroy();
 
     std::vector<Vertice*> insertVerticesAlongEdge(int count, Mesh* parentMesh);
 
     Vertice* getStart() const;
     Vertice* getEnd() const;
+    // endpoints moved by the parent mesh, which keeps its edge index in step
+    void rewire(Vertice* start, Vertice* end);
 
     void setSelected(bool isSelected);
     bool isSelected() const;
@@ -32,12 +36,21 @@ public:
 
     void splitEdge(Vertice* newVertice, Mesh* parentMesh);
 
-    std::string getID() const { return id; }
+    uint64_t getID() const { return id; }
     void setSharedFaces(const std::vector<class Face*>& faces);
     const std::vector<class Face*>& getSharedFaces() const;
     std::vector<class Face*>& getSharedFacesNonConst() { return sharedFaces; }
+    // kept in step by Face::linkAdjacency / unlinkAdjacency
+    void addSharedFace(class Face* f);
+    void removeSharedFace(class Face* f);
 
-    bool hasbeenMarkedOnceInCutQuad = false;
+    // handle inside the parent mesh's MeshTopology
+    void setTopologySlot(uint32_t slot) { topologySlot = slot; }
+    uint32_t getTopologySlot() const { return topologySlot; }
+
+    // position in the parent mesh's edge list, lets the mesh swap-remove it
+    void setListSlot(uint32_t slot) { listSlot = slot; }
+    uint32_t getListSlot() const { return listSlot; }
 
 private:
     Vertice* v1;
@@ -45,16 +58,10 @@ private:
 
     std::vector<class Face*> sharedFaces;
     bool quadEdge = false;
+    uint32_t topologySlot = UINT32_MAX;
+    uint32_t listSlot = UINT32_MAX;
 
-    unsigned int vao = 0;
-    unsigned int vbo = 0;
-    unsigned int shaderProgram = 0;
-
-    glm::vec4 color = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f); 
     bool edgeSelected = false;
 
-    void compileShaders();
-
-    std::string id;
-    static std::string generateEdgeID();
+    uint64_t id = 0;
 };
\ No newline at end of file
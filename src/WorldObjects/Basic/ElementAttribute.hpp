@@ -0,0 +1,50 @@
+#pragma once
+#include <unordered_map>
+#include <cstddef>
+
+// Out-of-line attribute for mesh elements that few of them ever change
+// (names, colors, face transforms). Only elements holding a value other
+// than the fallback take an entry, so the element itself stays small and
+// the common case costs one failed lookup on an empty map.
+template <typename Element, typename Value>
+class ElementAttribute
+{
+public:
+    explicit ElementAttribute(const Value& fallback) : fallback(fallback) {}
+
+    const Value& get(const Element* element) const
+    {
+        if (values.empty())
+            return fallback;
+        auto it = values.find(element);
+        return it != values.end() ? it->second : fallback;
+    }
+
+    void set(const Element* element, const Value& value)
+    {
+        if (value == fallback)
+            erase(element);
+        else
+            values[element] = value;
+    }
+
+    void erase(const Element* element)
+    {
+        if (!values.empty())
+            values.erase(element);
+    }
+
+    size_t size() const { return values.size(); }
+
+    // heap estimate : one node per entry plus the bucket array
+    size_t bytes() const
+    {
+        return values.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*))
+            + values.bucket_count() * sizeof(void*);
+    }
+
+private:
+    using Map = std::unordered_map<const Element*, Value>;
+    Map values;
+    Value fallback;
+};
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+
+// Ids for vertices, edges and faces : one process-wide monotonic counter, so
+// an id is never reused and 0 means "no element". Compared and hashed as integers.
+class ElementID
+{
+public:
+    static uint64_t next() { return ++counter; }
+
+private:
+    static inline uint64_t counter = 0;
+};
@@ -1,12 +1,24 @@
 #pragma once
+#include "WorldObjects/Basic/ElementID.hpp"
 
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include <cstdint>
 
 class Vertice;
 class Edge;
 
+// concrete face type, set once by the constructor so hot paths can branch
+// and static_cast without RTTI
+enum class FaceKind : uint8_t
+{
+    Generic,
+    Quad,
+    Triangle,
+    Ngon
+};
+
 class Face
 {
 public:
@@ -15,19 +27,20 @@ public:
         Edge* e0, Edge* e1, Edge* e2, Edge* e3);
     virtual ~Face();
 
+    // GPU resources live in the parent mesh's MeshRenderCache
     void initialize();
-    void render(const glm::mat4& viewProj, const glm::mat4& modelMatrix);
     void destroy();
 
     const std::vector<Vertice*>& getVertices() const;
     const std::vector<Edge*>& getEdges() const;
     std::vector<Edge*>& getEdgesNonConst() { return edges; }
 
-    const glm::mat4& getFaceTransform() const { return faceTransform; }
-    void setFaceTransform(const glm::mat4& m) { faceTransform = m; }
+    // pending (unbaked) transform, identity for almost every face
+    const glm::mat4& getFaceTransform() const;
+    void setFaceTransform(const glm::mat4& m);
     void applyWorldDelta(const glm::mat4& deltaWorld, const glm::mat4& parentModel, bool bakeToVertices);
 
-    void setSelected(bool v) { selected = v; }
+    void setSelected(bool v);
     bool isSelected() const { return selected; }
 
     void setParentMesh(class Mesh* mesh);
@@ -36,28 +49,34 @@ public:
     void setColor(const glm::vec4& c);
     const glm::vec4& getColor() const;
 
-    std::string getID() const { return id; }
-    bool isJoiningQuad = false;
+    uint64_t getID() const { return id; }
+    FaceKind getKind() const { return kind; }
+    bool isQuad() const { return kind == FaceKind::Quad; }
+
+    // registers / withdraws this face in its edges' shared faces and its
+    // vertices' face lists; called whenever the face enters or leaves a mesh
+    void linkAdjacency();
+    void unlinkAdjacency();
+
+    // corners moved by the parent mesh, same count as before; the caller
+    // unlinks the face before and links it again after
+    void rewire(const std::vector<Vertice*>& newVertices, const std::vector<Edge*>& newEdges);
+
+    // handle inside the parent mesh's MeshTopology
+    void setTopologySlot(uint32_t slot) { topologySlot = slot; }
+    uint32_t getTopologySlot() const { return topologySlot; }
 
 protected:
     std::vector<Vertice*> vertices;
     std::vector<Edge*> edges;
+    FaceKind kind = FaceKind::Generic;
 
 private:
-    unsigned int vao = 0;
-    unsigned int vbo = 0;
-    unsigned int shaderProgram = 0;
-
     bool selected = false;
-    glm::mat4 faceTransform = glm::mat4(1.0f);
 
     Mesh* parentMesh = nullptr;
+    uint32_t topologySlot = UINT32_MAX;
 
-    glm::vec4 color = glm::vec4(1.0f); 
-
-    std::string id;
-    static std::string generateFaceID();
 
-    void compileShaders();
-    void uploadFromVertices();
+    uint64_t id = 0;
 };
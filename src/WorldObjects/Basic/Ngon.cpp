@@ -4,7 +4,10 @@
 
 
 Ngon::Ngon(const std::vector<int>& vertexIndices)
-    : Face(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr), m_vertexIndices(vertexIndices) {}
+    : Face(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr), m_vertexIndices(vertexIndices)
+{
+    kind = FaceKind::Ngon;
+}
 
 Ngon::Ngon(const std::vector<Vertice*>& vertices, const std::vector<Edge*>& edges)
     : Face(
@@ -18,6 +21,7 @@ Ngon::Ngon(const std::vector<Vertice*>& vertices, const std::vector<Edge*>& edge
         edges.size() > 3 ? edges[3] : nullptr
       )
 {
+    kind = FaceKind::Ngon;
     this->vertices = vertices;
     this->edges = edges;
 }
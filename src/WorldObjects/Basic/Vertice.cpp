@@ -1,57 +1,23 @@
 #include "WorldObjects/Basic/Vertice.hpp"
-#include <glad/glad.h>
-#include <glm/gtc/type_ptr.hpp>
+#include "WorldObjects/Mesh/Mesh.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
-#include <sstream>
-#include <random>
 
-const char* verticeVertexShader = R"(
-#version 330 core
-layout(location = 0) in vec3 aPos;
-uniform mat4 model;
-uniform mat4 viewProj;
-void main()
+// names and colors are rarely set, they live out of line in the mesh's side tables
+static Mesh* meshOf(const Vertice* v)
 {
-    gl_PointSize = 10.0;
-    gl_Position = viewProj * model * vec4(aPos, 1.0);
+    ThreeDObject* parent = v->getMeshParent();
+    return parent && parent->getIsMesh() ? static_cast<Mesh*>(parent) : nullptr;
 }
-)";
 
-const char* verticeFragmentShader = R"(
-#version 330 core
-out vec4 FragColor;
-
-uniform vec4 color;
-
-void main()
+static const Mesh::Attributes& tablesOf(const Vertice* v)
 {
-    vec2 coord = gl_PointCoord - vec2(0.5);
-    float dist = dot(coord, coord);
-
-    // draw a circle 
-    if (dist > 0.25) 
-        discard;
-
-    FragColor = color;
+    const Mesh* mesh = meshOf(v);
+    return mesh ? mesh->attributes() : Mesh::defaultAttributes();
 }
-)";
 
 Vertice::Vertice() {
-    id = generateVerticeID();
-}
-
-std::string Vertice::generateVerticeID()
-{
-    static const char charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
-    static const size_t idLength = 12;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, sizeof(charset) - 2);
-    std::stringstream ss;
-    for (size_t i = 0; i < idLength; ++i)
-        ss << charset[dis(gen)];
-    return ss.str();
+    id = ElementID::next();
 }
 
 Vertice::~Vertice()
@@ -59,97 +25,40 @@ Vertice::~Vertice()
     destroy();
 }
 
-void Vertice::compileShaders()
-{
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &verticeVertexShader, nullptr);
-    glCompileShader(vertexShader);
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &verticeFragmentShader, nullptr);
-    glCompileShader(fragmentShader);
-
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-}
-
 void Vertice::initialize()
 {
-    compileShaders();
-
-    float vertex[] = { 0.0f, 0.0f, 0.0f };
-
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertex), vertex, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glBindVertexArray(0);
-}
-
-void Vertice::render(const glm::mat4& viewProj, const glm::mat4& modelMatrix)
-{
-    glUseProgram(shaderProgram);
-
-    glm::vec3 worldPos = glm::vec3(modelMatrix * glm::vec4(localPosition, 1.0f));
-    glm::mat4 renderMatrix = glm::translate(glm::mat4(1.0f), worldPos);
-
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(renderMatrix));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "viewProj"), 1, GL_FALSE, glm::value_ptr(viewProj));
-
-        glm::vec4 finalColor = isSelected()
-        ? glm::vec4(1.0f, 0.5f, 0.0f, 1.0f) 
-        : color;                           
-
-    glUniform4fv(glGetUniformLocation(shaderProgram, "color"), 1, glm::value_ptr(finalColor));
-
-    glEnable(GL_PROGRAM_POINT_SIZE);
-    glBindVertexArray(vao);
-    glDrawArrays(GL_POINTS, 0, 1);
-    glBindVertexArray(0);
 }
 
 void Vertice::destroy()
 {
-    if (vao != 0) {
-        glDeleteVertexArrays(1, &vao);
-        vao = 0;
-    }
-
-    if (vbo != 0) {
-        glDeleteBuffers(1, &vbo);
-        vbo = 0;
-    }
-
-    if (shaderProgram != 0) {
-        glDeleteProgram(shaderProgram);
-        shaderProgram = 0;
-    }
 }
 
 void Vertice::setColor(const glm::vec4& newColor)
 {
-    color = newColor;
+    Mesh* mesh = meshOf(this);
+    if (!mesh)
+        return;
+
+    mesh->attributes().vertexColors.set(this, newColor);
+    SceneRevision::bump();
+    mesh->markElementStateDirty(PickTarget::Vertice, true);
 }
 
 glm::vec4 Vertice::getColor() const
 {
-    return color;
+    return tablesOf(this).vertexColors.get(this);
 }
 
 void Vertice::setLocalPosition(const glm::vec3& pos)
 {
+    Mesh* mesh = meshParent && meshParent->getIsMesh() ? static_cast<Mesh*>(meshParent) : nullptr;
+    // an open edit keeps the position the vertex had before it
+    if (mesh && mesh->isEditing())
+        mesh->recordVerticeMove(this);
+
     localPosition = pos;
+    if (mesh)
+        mesh->markVerticeDirty(renderSlot, localPosition);
 }
 
 glm::vec3 Vertice::getLocalPosition() const
@@ -157,29 +66,27 @@ glm::vec3 Vertice::getLocalPosition() const
     return localPosition;
 }
 
-void Vertice::setPosition(const glm::vec3& pos)
+glm::vec3 Vertice::getPosition() const
 {
-    position = pos;
-}
-
-glm::vec3 Vertice::getPosition() const {
-
-    return glm::vec3(getModelMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    if (!meshParent)
+        return localPosition;
+    return glm::vec3(meshParent->getModelMatrix() * glm::vec4(localPosition, 1.0f));
 }
 
 void Vertice::setName(const std::string& newName)
 {
-    name = newName;
+    if (Mesh* mesh = meshOf(this))
+        mesh->attributes().vertexNames.set(this, newName);
 }
 
 const std::string& Vertice::getName() const
 {
-    return name;
+    return tablesOf(this).vertexNames.get(this);
 }
 
 glm::mat4 Vertice::getModelMatrix() const
 {
-    return glm::translate(glm::mat4(1.0f), position);
+    return glm::translate(glm::mat4(1.0f), getPosition());
 }
 
 void Vertice::setMeshParent(ThreeDObject* parent)
@@ -194,7 +101,13 @@ ThreeDObject* Vertice::getMeshParent() const
 
 void Vertice::setSelected(bool isSelected)
 {
+    if (VerticeSelected == isSelected)
+        return;
+
     VerticeSelected = isSelected;
+    SceneRevision::bump();
+    if (meshParent && meshParent->getIsMesh())
+        static_cast<Mesh*>(meshParent)->markElementStateDirty(PickTarget::Vertice, false);
 }
 
 bool Vertice::isSelected() const
@@ -206,7 +119,7 @@ void Vertice::applyTranslationToLocal(const glm::vec3& translation, const glm::m
 {
     glm::mat4 invParent = glm::inverse(parentModelMatrix);
     glm::vec3 localTranslation = glm::vec3(invParent * glm::vec4(translation, 0.0f));
-    localPosition += localTranslation;
+    setLocalPosition(localPosition + localTranslation);
 }
 
 void Vertice::addEdge(Edge* e)
@@ -223,6 +136,32 @@ const std::vector<Edge*>& Vertice::getEdges() const
 void Vertice::removeEdge(Edge* e)
 {
     auto it = std::find(edges.begin(), edges.end(), e);
-    if (it != edges.end())
-        edges.erase(it);
+    if (it == edges.end())
+        return;
+
+    // order of a vertex's edges is not relied on, swap-remove
+    *it = edges.back();
+    edges.pop_back();
+}
+
+void Vertice::reserveAdjacency(size_t edgeCount, size_t faceCount)
+{
+    edges.reserve(edgeCount);
+    faces.reserve(faceCount);
+}
+
+void Vertice::addFace(Face* f)
+{
+    if (f && std::find(faces.begin(), faces.end(), f) == faces.end())
+        faces.push_back(f);
+}
+
+void Vertice::removeFace(Face* f)
+{
+    auto it = std::find(faces.begin(), faces.end(), f);
+    if (it == faces.end())
+        return;
+
+    *it = faces.back();
+    faces.pop_back();
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
+#include "WorldObjects/Basic/ElementID.hpp"
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 class ThreeDObject; 
 class Vertice
@@ -9,11 +12,11 @@ public:
     Vertice();
     ~Vertice();
 
+    // GPU resources live in the parent mesh's MeshRenderCache
     void initialize();
-    void render(const glm::mat4& viewProj, const glm::mat4& modelMatrix);
     void destroy();
 
-    void setPosition(const glm::vec3 &pos);
+    // world position, derived from the local one and the parent's model matrix
     glm::vec3 getPosition() const;
 
     void setColor(const glm::vec4 &color);
@@ -39,23 +42,33 @@ public:
     const std::vector<class Edge*>& getEdges() const;
     void removeEdge(class Edge* e);
 
-    std::string getID() const { return id; }
+    // faces using this vertex, kept in step by Face::linkAdjacency / unlinkAdjacency
+    void addFace(class Face* f);
+    const std::vector<class Face*>& getFaces() const { return faces; }
+    void removeFace(class Face* f);
+    // for operators that know a vertex's valence before linking it
+    void reserveAdjacency(size_t edgeCount, size_t faceCount);
+
+    uint64_t getID() const { return id; }
+
+    // position of this vertex inside the parent mesh's GPU buffer
+    void setRenderSlot(uint32_t slot) { renderSlot = slot; }
+    uint32_t getRenderSlot() const { return renderSlot; }
+
+    // handle inside the parent mesh's MeshTopology
+    void setTopologySlot(uint32_t slot) { topologySlot = slot; }
+    uint32_t getTopologySlot() const { return topologySlot; }
 
 private:
     ThreeDObject* meshParent = nullptr;
-    unsigned int vao = 0;
-    unsigned int vbo = 0;
-    unsigned int shaderProgram = 0;
-    glm::vec3 position = glm::vec3(0.0f);
-    glm::vec4 color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
-    std::string name;
-    glm::vec3 localPosition;
+    uint32_t renderSlot = UINT32_MAX;
+    uint32_t topologySlot = UINT32_MAX;
+    glm::vec3 localPosition = glm::vec3(0.0f);
 
     std::vector<class Edge*> edges;
+    std::vector<class Face*> faces;
 
-    std::string id;
-    static std::string generateVerticeID();
+    uint64_t id = 0;
 
-    void compileShaders();
     bool VerticeSelected = false;
 };
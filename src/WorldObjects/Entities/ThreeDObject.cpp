@@ -1,7 +1,5 @@
 #include "WorldObjects/Entities/ThreedObject.hpp"
 #include <glm/gtc/type_ptr.hpp>
-#include <imgui.h>
-#include <ImGuizmo.h>
 #include <glm/gtx/matrix_decompose.hpp>
 #include <random>
 
@@ -9,7 +7,11 @@ ThreeDObject::ThreeDObject() {
 id = generateRandomID();
 }
 
-ThreeDObject::~ThreeDObject() {}
+ThreeDObject::~ThreeDObject()
+{
+    if (sceneBVH)
+        sceneBVH->remove(this);
+}
 
 // ---- générate random ID ----- //
 
@@ -21,9 +23,9 @@ uint64_t ThreeDObject::generateRandomID() {
     return dis(gen);
 }
 
-void ThreeDObject::translate(const glm::vec3 &newPosition) { position = newPosition; }
-void ThreeDObject::rotate(const glm::vec3 &newEulerRotationDegrees) { rotation = glm::quat(glm::radians(newEulerRotationDegrees)); }
-void ThreeDObject::scale(const glm::vec3 &newScale) { _scale = newScale; }
+void ThreeDObject::translate(const glm::vec3 &newPosition) { position = newPosition; transformChanged(); }
+void ThreeDObject::rotate(const glm::vec3 &newEulerRotationDegrees) { rotation = glm::quat(glm::radians(newEulerRotationDegrees)); transformChanged(); }
+void ThreeDObject::scale(const glm::vec3 &newScale) { _scale = newScale; transformChanged(); }
 
 void ThreeDObject::setParent(ThreeDObject *newParent)
 {
@@ -46,13 +48,17 @@ glm::vec3 ThreeDObject::getCenter() const { return position; }
 
 // ----  get set model matrix ----
 
-glm::mat4 ThreeDObject::getModelMatrix() const
+const glm::mat4& ThreeDObject::getModelMatrix() const
 {
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, position);
-    model *= glm::toMat4(rotation);
-    model = glm::scale(model, _scale);
-    return model;
+    if (modelDirty)
+    {
+        cachedModel = glm::mat4(1.0f);
+        cachedModel = glm::translate(cachedModel, position);
+        cachedModel *= glm::toMat4(rotation);
+        cachedModel = glm::scale(cachedModel, _scale);
+        modelDirty = false;
+    }
+    return cachedModel;
 }
 
 void ThreeDObject::setModelMatrix(const glm::mat4 &matrix)
@@ -68,7 +74,7 @@ void ThreeDObject::setModelMatrix(const glm::mat4 &matrix)
         position = positionTmp;
         _scale = scaleTmp;
         rotation = glm::normalize(rotationTmp);
-        
+        transformChanged();
     }
 }
 
@@ -7,6 +7,8 @@
 #include <string>
 #include <iostream>
 #include <list>
+#include "Engine/SceneRevision.hpp"
+#include "Engine/SceneBVH.hpp"
 
 class ThreeDObject
 {
@@ -21,19 +23,27 @@ public:
     virtual void render(const glm::mat4 &viewProj) = 0;
     virtual void destroy() {}
 
+    // local-space bounding box; objects without geometry return false and are never culled
+    virtual bool getLocalBounds(glm::vec3& /*outMin*/, glm::vec3& /*outMax*/) const { return false; }
+
     glm::vec3 getPosition() const { return position; }
     glm::vec3 getRotation() const { return glm::degrees(glm::eulerAngles(rotation)); }
     glm::vec3 getScale() const { return _scale; }
 
-    void setPosition(const glm::vec3 &pos) { position = pos; }
-    void setRotation(const glm::vec3 &eulerDegrees) { rotation = glm::quat(glm::radians(eulerDegrees)); }
-    void setScale(const glm::vec3 &scl) { _scale = scl; }
+    void setPosition(const glm::vec3 &pos) { position = pos; transformChanged(); }
+    void setRotation(const glm::vec3 &eulerDegrees) { rotation = glm::quat(glm::radians(eulerDegrees)); transformChanged(); }
+    void setScale(const glm::vec3 &scl) { _scale = scl; transformChanged(); }
+
+    // changes whenever the world-space bounds may have moved (transform or geometry);
+    // values are unique across objects so a recycled address never looks unchanged
+    uint64_t getBoundsVersion() const { return boundsVersion; }
 
     void translate(const glm::vec3 &newPosition);
     void rotate(const glm::vec3 &newEulerRotationDegrees);
     void scale(const glm::vec3 &newScale);
 
-    glm::mat4 getModelMatrix() const;
+    // composed from position / rotation / scale on first use after a change
+    const glm::mat4& getModelMatrix() const;
     void setModelMatrix(const glm::mat4 &matrix);
     glm::vec3 getCenter() const;
 
@@ -41,7 +51,11 @@ public:
 
     glm::mat4 getGlobalModelMatrix() const;
 
-    void setSelected(bool selected) { isCurrentlySelected = selected; }
+    void setSelected(bool selected)
+    {
+        if (isCurrentlySelected != selected) SceneRevision::bump();
+        isCurrentlySelected = selected;
+    }
     bool getSelected() const { return isCurrentlySelected; }
     virtual bool isSelectable() const { return true; }
 
@@ -102,4 +116,25 @@ protected:
 
     bool isMesh = false;
     std::vector<int> changedSlots;
+
+    void bumpBoundsVersion()
+    {
+        boundsVersion = ++boundsVersionCounter;
+        SceneRevision::bump();
+        if (sceneBVH) sceneBVH->markDirty(bvhLeaf);
+    }
+    void transformChanged() { modelDirty = true; bumpBoundsVersion(); }
+
+private:
+    friend class SceneBVH;
+
+    // the scene tree holding this object, if any, and the leaf it sits in
+    SceneBVH* sceneBVH = nullptr;
+    int bvhLeaf = -1;
+
+    mutable glm::mat4 cachedModel = glm::mat4(1.0f);
+    mutable bool modelDirty = true;
+
+    uint64_t boundsVersion = ++boundsVersionCounter;
+    static inline uint64_t boundsVersionCounter = 0;
 };
@@ -0,0 +1,199 @@
+#include "WorldObjects/Mesh/ElementPool.hpp"
+#include <new>
+#include <algorithm>
+#include <utility>
+#include <functional>
+
+ElementPool::ElementPool(size_t size, size_t align, Destructor destroy)
+    : slotAlign(std::max(align, alignof(void*))), destructor(destroy)
+{
+    // every slot must hold the free-list link and keep its neighbours aligned
+    const size_t minSize = std::max(size, sizeof(void*));
+    slotSize = (minSize + slotAlign - 1) / slotAlign * slotAlign;
+}
+
+ElementPool::~ElementPool()
+{
+    clear();
+}
+
+void ElementPool::growSlab()
+{
+    const size_t slots = slabs.empty() ? kFirstSlabSlots : std::min(slabs.back().slots * 2, kMaxSlabSlots);
+
+    Slab slab;
+    slab.memory = static_cast<unsigned char*>(::operator new(slots * slotSize, std::align_val_t(slotAlign)));
+    slab.slots = slots;
+    slab.first = capacity;
+    slab.generations.assign(slots, 1u);
+
+    const auto at = std::upper_bound(slabsByAddress.begin(), slabsByAddress.end(), slab.memory,
+        [this](const unsigned char* memory, size_t i) { return std::less<const unsigned char*>()(memory, slabs[i].memory); });
+    slabsByAddress.insert(at, slabs.size());
+    slabs.push_back(std::move(slab));
+
+    bumpUsed = 0;
+    capacity += slots;
+}
+
+void* ElementPool::allocate()
+{
+    void* slot = nullptr;
+    if (freeList)
+    {
+        slot = freeList;
+        freeList = *static_cast<void**>(freeList);
+    }
+    else
+    {
+        if (slabs.empty() || bumpUsed == slabs.back().slots)
+            growSlab();
+        slot = slabs.back().memory + bumpUsed * slotSize;
+        ++bumpUsed;
+    }
+
+    ++live;
+    return slot;
+}
+
+void ElementPool::release(void* slot)
+{
+    if (!slot) return;
+
+    // outstanding refs to this slot go stale; 0 stays reserved for "unstamped"
+    if (Slab* slab = findSlab(slot))
+    {
+        uint32_t& gen = slab->generations[(static_cast<unsigned char*>(slot) - slab->memory) / slotSize];
+        if (++gen == 0)
+            gen = 1;
+    }
+
+    *static_cast<void**>(slot) = freeList;
+    freeList = slot;
+    --live;
+}
+
+size_t ElementPool::findSlabIndex(const void* p) const
+{
+    // last slab starting at or before p, then check p is inside it
+    const unsigned char* bytes = static_cast<const unsigned char*>(p);
+    const std::less<const unsigned char*> before;
+    const auto next = std::upper_bound(slabsByAddress.begin(), slabsByAddress.end(), bytes,
+        [&](const unsigned char* b, size_t i) { return before(b, slabs[i].memory); });
+    if (next == slabsByAddress.begin())
+        return slabs.size();
+
+    const size_t i = *(next - 1);
+    if (!before(bytes, slabs[i].memory + slabs[i].slots * slotSize))
+        return slabs.size();
+    return i;
+}
+
+const ElementPool::Slab* ElementPool::findSlab(const void* p) const
+{
+    const size_t i = findSlabIndex(p);
+    return i < slabs.size() ? &slabs[i] : nullptr;
+}
+
+ElementPool::Slab* ElementPool::findSlab(const void* p)
+{
+    return const_cast<Slab*>(static_cast<const ElementPool*>(this)->findSlab(p));
+}
+
+bool ElementPool::owns(const void* p) const
+{
+    return findSlab(p) != nullptr;
+}
+
+uint32_t ElementPool::generationOf(const void* p) const
+{
+    const Slab* slab = findSlab(p);
+    if (!slab)
+        return 0;
+    return slab->generations[(static_cast<const unsigned char*>(p) - slab->memory) / slotSize];
+}
+
+size_t ElementPool::slotIndexOf(const void* p) const
+{
+    const Slab* slab = findSlab(p);
+    if (!slab)
+        return SIZE_MAX;
+    return slab->first + (static_cast<const unsigned char*>(p) - slab->memory) / slotSize;
+}
+
+uint32_t* ElementPool::markOf(const void* p)
+{
+    const size_t i = findSlabIndex(p);
+    if (i == slabs.size())
+        return nullptr;
+
+    Slab& slab = slabs[i];
+    if (slab.marks.empty())
+    {
+        slab.marks.assign(slab.slots, kNoMark);
+        markedSlabs.push_back(i);
+    }
+    return &slab.marks[(static_cast<const unsigned char*>(p) - slab.memory) / slotSize];
+}
+
+void ElementPool::clearMarks()
+{
+    for (size_t i : markedSlabs)
+        std::vector<uint32_t>().swap(slabs[i].marks);
+    markedSlabs.clear();
+}
+
+void ElementPool::destroyLive()
+{
+    if (!destructor || live == 0)
+        return;
+
+    // every slot handed out and not on the free list still holds an object
+    std::vector<std::vector<char>> freed(slabs.size());
+    for (size_t i = 0; i < slabs.size(); ++i)
+        freed[i].assign(slabs[i].slots, 0);
+    for (void* slot = freeList; slot; slot = *static_cast<void**>(slot))
+    {
+        const size_t i = findSlabIndex(slot);
+        if (i < slabs.size())
+            freed[i][(static_cast<unsigned char*>(slot) - slabs[i].memory) / slotSize] = 1;
+    }
+
+    for (size_t i = 0; i < slabs.size(); ++i)
+    {
+        // only the newest slab can have slots never handed out
+        const size_t used = i + 1 == slabs.size() ? bumpUsed : slabs[i].slots;
+        for (size_t s = 0; s < used; ++s)
+        {
+            if (!freed[i][s])
+                destructor(slabs[i].memory + s * slotSize);
+        }
+    }
+}
+
+void ElementPool::clear()
+{
+    destroyLive();
+
+    for (const Slab& slab : slabs)
+        ::operator delete(slab.memory, std::align_val_t(slotAlign));
+
+    slabs.clear();
+    slabsByAddress.clear();
+    markedSlabs.clear();
+    freeList = nullptr;
+    bumpUsed = 0;
+    live = 0;
+    capacity = 0;
+}
+
+ElementPool::Stats ElementPool::stats() const
+{
+    Stats s;
+    s.slabCount = slabs.size();
+    s.capacity = capacity;
+    s.live = live;
+    s.bytesReserved = capacity * slotSize;
+    s.bytesLive = live * slotSize;
+    return s;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Slab allocator for one kind of mesh element. Slots are carved out of
+// slabs that double in size (up to kMaxSlabSlots), freed slots go on an
+// intrusive free list, and all slabs are returned to the heap at once when
+// the pool is cleared or destroyed.
+//
+// The pool hands out raw memory : the owner placement-constructs into it
+// and runs the destructor before release(). Objects still live when the
+// slabs go are finished with the destructor given at construction. Every
+// slot carries a generation that release() bumps, which is what ElementRef
+// checks against. While an edit is open the owner may also keep a mark
+// per slot, see markOf.
+class ElementPool
+{
+public:
+    struct Stats
+    {
+        size_t slabCount = 0;
+        size_t capacity = 0;      // slots in all slabs
+        size_t live = 0;          // slots currently handed out
+        size_t bytesReserved = 0;
+        size_t bytesLive = 0;
+    };
+
+    // runs the destructor of the object placed in a slot
+    using Destructor = void (*)(void* slot);
+
+    ElementPool(size_t slotSize, size_t slotAlign, Destructor destructor = nullptr);
+    ~ElementPool();
+
+    ElementPool(const ElementPool&) = delete;
+    ElementPool& operator=(const ElementPool&) = delete;
+
+    void* allocate();
+    void release(void* slot);
+
+    // true when p points into one of this pool's slabs
+    bool owns(const void* p) const;
+
+    // generation of the slot holding p, 0 when p is not from this pool
+    uint32_t generationOf(const void* p) const;
+
+    // number of the slot holding p, counted across every slab and below
+    // slotCount(), so a pass can keep per-element data in a plain array;
+    // SIZE_MAX when p is not from this pool
+    size_t slotIndexOf(const void* p) const;
+    size_t slotCount() const { return capacity; }
+
+    // scratch word of the slot holding p, kNoMark until set; nullptr when p is
+    // not from this pool. Slabs get their marks on first use, clearMarks drops them
+    static constexpr uint32_t kNoMark = UINT32_MAX;
+    uint32_t* markOf(const void* p);
+    void clearMarks();
+
+    // destroys the objects still live, then drops every slab
+    void clear();
+
+    size_t liveCount() const { return live; }
+    Stats stats() const;
+
+private:
+    struct Slab
+    {
+        unsigned char* memory = nullptr;
+        size_t slots = 0;
+        size_t first = 0;  // slotIndexOf its first slot
+        std::vector<uint32_t> generations;
+        std::vector<uint32_t> marks;  // empty until markOf reaches the slab
+    };
+
+    static constexpr size_t kFirstSlabSlots = 256;
+    static constexpr size_t kMaxSlabSlots = 65536;
+
+    void growSlab();
+    void destroyLive();
+    size_t findSlabIndex(const void* p) const;  // slabs.size() when not found
+    const Slab* findSlab(const void* p) const;
+    Slab* findSlab(const void* p);
+
+    size_t slotSize;
+    size_t slotAlign;
+    Destructor destructor;
+
+    std::vector<Slab> slabs;
+    std::vector<size_t> slabsByAddress;  // indices into slabs, sorted by memory, for findSlab
+    std::vector<size_t> markedSlabs;     // slabs holding marks, for clearMarks
+    void* freeList = nullptr;
+    size_t bumpUsed = 0;  // slots handed out from the newest slab so far
+    size_t live = 0;
+    size_t capacity = 0;
+};
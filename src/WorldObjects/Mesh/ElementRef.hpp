@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+// Pointer to a mesh element stamped with the generation of its pool slot.
+// Mesh::resolve() hands the pointer back only while the slot still holds the
+// same element, so records that outlive an edit (undo history) can tell a
+// freed or recycled element from a live one.
+//
+// Converts implicitly to T* so code reading records keeps working; a
+// generation of 0 means "not stamped" and resolves without a check.
+template <typename T>
+class ElementRef
+{
+public:
+    ElementRef() = default;
+    ElementRef(T* element) : ptr(element) {}
+    ElementRef(T* element, uint32_t gen) : ptr(element), gen(gen) {}
+
+    T* get() const { return ptr; }
+    uint32_t generation() const { return gen; }
+
+    operator T*() const { return ptr; }
+    T* operator->() const { return ptr; }
+
+private:
+    T* ptr = nullptr;
+    uint32_t gen = 0;
+};
@@ -5,6 +5,9 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glad/glad.h>
 #include <iostream>
+#include <new>
+#include <algorithm>
+#include <unordered_set>
 
 Mesh::Mesh()
 {
@@ -23,91 +26,443 @@ void Mesh::initialize()
 
 Quad* Mesh::addQuad(const std::array<Vertice*, 4>& vertices, const std::array<Edge*, 4>& edges)
 {
-    auto* quad = new Quad(vertices, edges);
+    auto* quad = createQuad(vertices, edges);
+    quad->setParentMesh(this);
+    quad->linkAdjacency();
     faces.push_back(quad);
+    bumpTopologyVersion();
     return quad;
 }
 
 Triangle* Mesh::addTriangle(Vertice* v0, Vertice* v1, Vertice* v2, Edge* e0, Edge* e1, Edge* e2)
 {
-    auto* tri = new Triangle(v0, v1, v2, e0, e1, e2);
+    auto* tri = new (facePool.allocate()) Triangle(v0, v1, v2, e0, e1, e2);
+    recordAdded(tri);
+    tri->setParentMesh(this);
+    tri->linkAdjacency();
     faces.push_back(tri);
+    bumpTopologyVersion();
     return tri;
 }
 
 Ngon* Mesh::addNgon(const std::vector<Vertice*>& vertices, const std::vector<Edge*>& edges)
 {
-    auto* ngon = new Ngon(vertices, edges);
+    auto* ngon = new (facePool.allocate()) Ngon(vertices, edges);
+    recordAdded(ngon);
+    ngon->setParentMesh(this);
+    ngon->linkAdjacency();
     faces.push_back(ngon);
+    bumpTopologyVersion();
     return ngon;
 }
 
-void Mesh::render(const glm::mat4& viewProj)
+void Mesh::render(const glm::mat4&)
 {
     try 
     {
-        const glm::mat4 modelMatrix = getModelMatrix();
+        renderCache.render(*this, getModelMatrix());
 
-        glEnable(GL_POLYGON_OFFSET_FILL);
-        glPolygonOffset(1.0f, 1.0f);
-        for (Face* f : faces) 
+        if(CanDisplayRenderMessage)
         {
-            if (f) 
-            {
-                try 
-                {
-                    f->render(viewProj, modelMatrix);
-                } 
-                catch (const std::exception& e) 
-                {
-                    std::cerr << "[Mesh] Error rendering face: " << e.what() << std::endl;
-                }
-            }
+            std::cout << "[Mesh] Rendering completed (faces, vertices, edges)\n";
+            CanDisplayRenderMessage = false;
         }
-        glDisable(GL_POLYGON_OFFSET_FILL);
+    } 
+    catch (const std::exception& e) 
+    {
+        std::cerr << "[Mesh] Error in render method: " << e.what() << std::endl;
+    }
+}
+
+void Mesh::markVerticeDirty(uint32_t renderSlot, const glm::vec3& localPos)
+{
+    renderCache.markPositionDirty(renderSlot);
+    bvh.markPositionsDirty();
+    topology.markPositionsDirty();
+
+    if (editDepth > 0)
+        editChanged = true;
+    else
+        bumpBoundsVersion();
+
+    if (!boundsDirty)
+    {
+        boundsMin = glm::min(boundsMin, localPos);
+        boundsMax = glm::max(boundsMax, localPos);
+    }
+}
+
+// ---- edit transactions ---- //
+
+void Mesh::beginEdit()
+{
+    if (editDepth++ > 0)
+        return;
+
+    editChanged = false;
+    editStartVersion = topologyVersion;
+    editStartVertices = vertices.size();
+    editStartEdges = edges.size();
+    editStartFaces = faces.size();
+
+    // without a MeshDNA there is no history to write the record to
+    recording = meshDNA != nullptr;
+}
+
+void Mesh::commitEdit(const std::string& tag)
+{
+    if (editDepth == 0 || --editDepth > 0)
+        return;
+
+    TopologyEditRecord rec = std::move(editRecord);
+    stopRecording();
+
+    if (!editChanged)
+        return;
+    editChanged = false;
+
+    // render cache, BVH and topology view key on the topology version and
+    // rebuild lazily on their next use, so one scene bump is all they need
+    bumpBoundsVersion();
+
+    // vertex moves alone are tracked by the transform events
+    if (meshDNA && topologyVersion != editStartVersion)
+    {
+        rec.verticeDelta = static_cast<int64_t>(vertices.size()) - static_cast<int64_t>(editStartVertices);
+        rec.edgeDelta = static_cast<int64_t>(edges.size()) - static_cast<int64_t>(editStartEdges);
+        rec.faceDelta = static_cast<int64_t>(faces.size()) - static_cast<int64_t>(editStartFaces);
+        // an empty tag leaves the history to the operator's own record
+        if (!tag.empty())
+            meshDNA->trackTopologyEdit(tag, std::move(rec));
+
+        meshDNA->setVerticeCount(vertices.size());
+        meshDNA->setEdgeCount(edges.size());
+        meshDNA->setQuadCount(getQuads().size());
+    }
+}
+
+// ---- transaction record ---- //
+
+void Mesh::stopRecording()
+{
+    recording = false;
+    editRecord = TopologyEditRecord{};
+    // a large edit leaves large mark tables, they are not kept for the next one
+    vertexPool.clearMarks();
+    edgePool.clearMarks();
+    facePool.clearMarks();
+    std::unordered_map<const void*, uint32_t>().swap(strayMarks);
+}
+
+void Mesh::reserveRecord(size_t verts, size_t edges, size_t faces, size_t corners)
+{
+    if (!recording) return;
+    editRecord.oldVerts.reserve(verts);
+    editRecord.oldPositions.reserve(verts);
+    editRecord.vertRetired.reserve(verts);
+    editRecord.oldEdges.reserve(edges);
+    editRecord.oldEdgeEnds.reserve(2 * edges);
+    editRecord.edgeRetired.reserve(edges);
+    editRecord.oldFaces.reserve(faces);
+    editRecord.oldFaceVerts.reserve(corners);
+    editRecord.oldFaceEdges.reserve(corners);
+    editRecord.oldSides.reserve(faces);
+    editRecord.oldKinds.reserve(faces);
+    editRecord.faceRetired.reserve(faces);
+}
+
+uint32_t& Mesh::editMark(ElementPool& pool, const void* element)
+{
+    if (uint32_t* mark = pool.markOf(element))
+        return *mark;
+    return strayMarks.try_emplace(element, ElementPool::kNoMark).first->second;
+}
+
+void Mesh::recordAdded(Vertice* v)
+{
+    if (!recording) return;
+    uint32_t& mark = editMark(vertexPool, v);
+    if (mark == kMadeInEdit) return;
+    mark = kMadeInEdit;
+    // elements from outside the pools carry no generation, a rewind cannot tell when they go
+    if (generationOf(v) != 0)
+        editRecord.addedVerts.push_back(makeRef(v));
+}
+
+void Mesh::recordAdded(Edge* e)
+{
+    if (!recording) return;
+    uint32_t& mark = editMark(edgePool, e);
+    if (mark == kMadeInEdit) return;
+    mark = kMadeInEdit;
+    if (generationOf(e) != 0)
+        editRecord.addedEdges.push_back(makeRef(e));
+}
+
+void Mesh::recordAdded(Face* f)
+{
+    if (!recording) return;
+    uint32_t& mark = editMark(facePool, f);
+    if (mark == kMadeInEdit) return;
+    mark = kMadeInEdit;
+    if (generationOf(f) != 0)
+        editRecord.addedFaces.push_back(makeRef(f));
+}
+
+void Mesh::recordBefore(Vertice* v)
+{
+    if (!recording || !v) return;
+    uint32_t& mark = editMark(vertexPool, v);
+    if (mark != ElementPool::kNoMark) return;
+    mark = static_cast<uint32_t>(editRecord.oldVerts.size());
+
+    editRecord.oldVerts.push_back(makeRef(v));
+    editRecord.oldPositions.push_back(v->getLocalPosition());
+    editRecord.vertRetired.push_back(0);
+}
+
+void Mesh::recordBefore(Edge* e)
+{
+    if (!recording || !e) return;
+    uint32_t& mark = editMark(edgePool, e);
+    if (mark != ElementPool::kNoMark) return;
+    mark = static_cast<uint32_t>(editRecord.oldEdges.size());
+
+    editRecord.oldEdges.push_back(makeRef(e));
+    editRecord.oldEdgeEnds.push_back(makeRef(e->getStart()));
+    editRecord.oldEdgeEnds.push_back(makeRef(e->getEnd()));
+    editRecord.edgeRetired.push_back(0);
+}
+
+void Mesh::recordBefore(Face* f)
+{
+    if (!recording || !f) return;
+    uint32_t& mark = editMark(facePool, f);
+    if (mark != ElementPool::kNoMark) return;
+    mark = static_cast<uint32_t>(editRecord.oldFaces.size());
+
+    const auto& vs = f->getVertices();
+    const auto& es = f->getEdges();
+    editRecord.oldFaces.push_back(makeRef(f));
+    for (size_t i = 0; i < vs.size(); ++i)
+    {
+        editRecord.oldFaceVerts.push_back(makeRef(vs[i]));
+        editRecord.oldFaceEdges.push_back(i < es.size() ? makeRef(es[i]) : ElementRef<Edge>());
+    }
+    editRecord.oldSides.push_back(static_cast<uint32_t>(vs.size()));
+    editRecord.oldKinds.push_back(static_cast<uint8_t>(f->getKind()));
+    editRecord.faceRetired.push_back(0);
+}
+
+// an element made and dropped within the same edit leaves no trace
+void Mesh::recordRetired(Vertice* v)
+{
+    if (!recording) return;
+    uint32_t& mark = editMark(vertexPool, v);
+    if (mark == kMadeInEdit) { mark = ElementPool::kNoMark; return; }
+    recordBefore(v);
+    editRecord.vertRetired[editMark(vertexPool, v)] = 1;
+}
+
+void Mesh::recordRetired(Edge* e)
+{
+    if (!recording) return;
+    uint32_t& mark = editMark(edgePool, e);
+    if (mark == kMadeInEdit) { mark = ElementPool::kNoMark; return; }
+    recordBefore(e);
+    editRecord.edgeRetired[editMark(edgePool, e)] = 1;
+}
+
+void Mesh::recordRetired(Face* f)
+{
+    if (!recording) return;
+    uint32_t& mark = editMark(facePool, f);
+    if (mark == kMadeInEdit) { mark = ElementPool::kNoMark; return; }
+    recordBefore(f);
+    editRecord.faceRetired[editMark(facePool, f)] = 1;
+}
+
+void Mesh::revertTopologyEdit(const TopologyEditRecord& rec, RevivedElements* revived)
+{
+    beginEdit();
+    // the rewind drops the record it works from, it writes none of its own
+    stopRecording();
 
-        for (Vertice* v : vertices) 
+    // ---- faces the edit made go, the ones it rewired let go of their current elements ---- //
+    std::unordered_set<Face*> madeFaces;
+    for (const auto& ref : rec.addedFaces)
+    {
+        if (Face* f = resolve(ref)) madeFaces.insert(f);
+    }
+    faces.erase(std::remove_if(faces.begin(), faces.end(),
+        [&](Face* f) { return madeFaces.count(f) != 0; }), faces.end());
+    for (Face* f : madeFaces)
+    {
+        f->unlinkAdjacency();
+        f->destroy();
+        freeFace(f);
+    }
+
+    for (size_t i = 0; i < rec.oldFaces.size(); ++i)
+    {
+        if (rec.faceRetired[i]) continue;
+        if (Face* f = resolve(rec.oldFaces[i])) f->unlinkAdjacency();
+    }
+
+    // ---- edges the edit made go, their vertices are still there ---- //
+    for (const auto& ref : rec.addedEdges)
+    {
+        Edge* e = resolve(ref);
+        if (!e) continue;
+        if (e->getStart()) e->getStart()->removeEdge(e);
+        if (e->getEnd()) e->getEnd()->removeEdge(e);
+        detachEdge(e);
+        e->destroy();
+        freeEdge(e);
+    }
+
+    // ---- old vertices : retired ones are made again, moved ones go back ---- //
+    // a retired element's ref no longer resolves, the revived copy stands in for it
+    std::unordered_map<const Vertice*, Vertice*> revivedVerts;
+    for (size_t i = 0; i < rec.oldVerts.size(); ++i)
+    {
+        if (rec.vertRetired[i])
         {
-            if (v) 
-            {
-                try 
-                {
-                    v->render(viewProj, modelMatrix);
-                } 
-                catch (const std::exception& e) 
-                {
-                    std::cerr << "[Mesh] Error rendering vertex: " << e.what() << std::endl;
-                }
-            }
+            Vertice* v = addVertice(rec.oldPositions[i]);
+            revivedVerts[rec.oldVerts[i].get()] = v;
+            if (revived) revived->verts.emplace_back(rec.oldVerts[i], makeRef(v));
         }
+        else if (Vertice* v = resolve(rec.oldVerts[i]))
+            v->setLocalPosition(rec.oldPositions[i]);
+    }
+    auto vertOf = [&](const ElementRef<Vertice>& ref)
+    {
+        auto it = revivedVerts.find(ref.get());
+        return it != revivedVerts.end() ? it->second : resolve(ref);
+    };
+
+    // ---- old edges : retired ones are made again, rewired ones get their ends back ---- //
+    std::unordered_map<const Edge*, Edge*> revivedEdges;
+    for (size_t i = 0; i < rec.oldEdges.size(); ++i)
+    {
+        Vertice* a = vertOf(rec.oldEdgeEnds[2 * i]);
+        Vertice* b = vertOf(rec.oldEdgeEnds[2 * i + 1]);
+        if (!a || !b) continue;
 
-        glLineWidth(2.0f);
-        for (Edge* e : edges) 
+        Edge* e = nullptr;
+        if (rec.edgeRetired[i])
         {
-            if (e) 
-            {
-                try 
-                {
-                    e->render(viewProj, modelMatrix);
-                } 
-                catch (const std::exception& e) 
-                {
-                    std::cerr << "[Mesh] Error rendering edge: " << e.what() << std::endl;
-                }
-            }
+            e = addEdge(a, b);
+            revivedEdges[rec.oldEdges[i].get()] = e;
+            if (revived) revived->edges.emplace_back(rec.oldEdges[i], makeRef(e));
+        }
+        else if ((e = resolve(rec.oldEdges[i])))
+        {
+            if (e->getStart()) e->getStart()->removeEdge(e);
+            if (e->getEnd()) e->getEnd()->removeEdge(e);
+            e->rewire(a, b);
         }
-        glLineWidth(1.0f);
+        if (!e) continue;
+        a->addEdge(e);
+        b->addEdge(e);
+    }
+    auto edgeOf = [&](const ElementRef<Edge>& ref)
+    {
+        auto it = revivedEdges.find(ref.get());
+        return it != revivedEdges.end() ? it->second : resolve(ref);
+    };
 
-        if(CanDisplayRenderMessage)
+    // ---- old faces : retired ones are made again as their kind, rewired ones relinked ---- //
+    std::vector<Vertice*> vs;
+    std::vector<Edge*> es;
+    size_t first = 0;
+    for (size_t i = 0; i < rec.oldFaces.size(); ++i)
+    {
+        const uint32_t sides = rec.oldSides[i];
+        vs.clear();
+        es.clear();
+        bool alive = true;
+        for (uint32_t k = 0; k < sides; ++k)
         {
-            std::cout << "[Mesh] Rendering completed (faces, vertices, edges)\n";
-            CanDisplayRenderMessage = false;
+            vs.push_back(vertOf(rec.oldFaceVerts[first + k]));
+            es.push_back(edgeOf(rec.oldFaceEdges[first + k]));
+            alive = alive && vs.back();
         }
-    } 
-    catch (const std::exception& e) 
+        first += sides;
+
+        if (!rec.faceRetired[i])
+        {
+            if (Face* f = resolve(rec.oldFaces[i]))
+            {
+                if (alive) f->rewire(vs, es);
+                f->linkAdjacency();
+            }
+            continue;
+        }
+        if (!alive || sides < 3) continue;
+
+        const FaceKind kind = static_cast<FaceKind>(rec.oldKinds[i]);
+        Face* f = nullptr;
+        if (sides == 4 && kind == FaceKind::Quad)
+            f = addQuad({ vs[0], vs[1], vs[2], vs[3] }, { es[0], es[1], es[2], es[3] });
+        else if (sides == 4 && kind == FaceKind::Generic)
+            f = addFace(vs[0], vs[1], vs[2], vs[3], es[0], es[1], es[2], es[3]);
+        else if (sides == 3)
+            f = addTriangle(vs[0], vs[1], vs[2], es[0], es[1], es[2]);
+        else
+            f = addNgon(vs, es);
+        if (revived && f) revived->faces.emplace_back(rec.oldFaces[i], makeRef(f));
+    }
+
+    // ---- vertices the edit made go last, nothing hangs on them any more ---- //
+    std::unordered_set<Vertice*> madeVerts;
+    for (const auto& ref : rec.addedVerts)
     {
-        std::cerr << "[Mesh] Error in render method: " << e.what() << std::endl;
+        if (Vertice* v = resolve(ref)) madeVerts.insert(v);
+    }
+    vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
+        [&](Vertice* v) { return madeVerts.count(v) != 0; }), vertices.end());
+    for (Vertice* v : madeVerts)
+    {
+        v->destroy();
+        freeVertice(v);
+    }
+
+    // rewired edges moved their keys, the edge index is rebuilt on the next lookup
+    edgeIndex.clear();
+    indexedEdgeCount = 0;
+
+    bumpTopologyVersion();
+    commitEdit({});
+}
+
+void Mesh::recomputeBounds() const
+{
+    bool first = true;
+    for (const Vertice* v : vertices)
+    {
+        if (!v) continue;
+        const glm::vec3 p = v->getLocalPosition();
+        boundsMin = first ? p : glm::min(boundsMin, p);
+        boundsMax = first ? p : glm::max(boundsMax, p);
+        first = false;
     }
+    if (first)
+        boundsMin = boundsMax = glm::vec3(0.0f);
+    boundsDirty = false;
+}
+
+bool Mesh::getLocalBounds(glm::vec3& outMin, glm::vec3& outMax) const
+{
+    if (vertices.empty())
+        return false;
+
+    if (boundsDirty)
+        recomputeBounds();
+
+    outMin = boundsMin;
+    outMax = boundsMax;
+    return true;
 }
 
 void Mesh::destroyVertices()
@@ -116,9 +471,10 @@ void Mesh::destroyVertices()
     {
         if (!v) continue;
         v->destroy();
-        delete v;
+        freeVertice(v);
     }
     vertices.clear();
+    bumpTopologyVersion();
 }
 
 void Mesh::destroyEdges()
@@ -127,9 +483,12 @@ void Mesh::destroyEdges()
     {
         if (!e) continue;
         e->destroy();
-        delete e;
+        freeEdge(e);
     }
     edges.clear();
+    edgeIndex.clear();
+    indexedEdgeCount = 0;
+    bumpTopologyVersion();
 }
 
 void Mesh::destroyFaces()
@@ -138,16 +497,19 @@ void Mesh::destroyFaces()
     {
         if (!f) continue;
         f->destroy();
-        delete f;
+        freeFace(f);
     }
     faces.clear();
+    bumpTopologyVersion();
 }
 
 void Mesh::destroy()
 {
+    renderCache.destroy();
     destroyVertices();
     destroyEdges();
     destroyFaces();
+    releaseEmptyPools();
 
     if (meshDNA && ownsDNA)
     {
@@ -158,6 +520,121 @@ void Mesh::destroy()
 
 }
 
+// ---- element storage ---- //
+
+Vertice* Mesh::createVertice()
+{
+    auto* v = new (vertexPool.allocate()) Vertice();
+    recordAdded(v);
+    return v;
+}
+
+Edge* Mesh::createEdge(Vertice* a, Vertice* b)
+{
+    auto* e = new (edgePool.allocate()) Edge(a, b);
+    recordAdded(e);
+    return e;
+}
+
+Quad* Mesh::createQuad(const std::array<Vertice*, 4>& vertices, const std::array<Edge*, 4>& edges)
+{
+    auto* quad = new (facePool.allocate()) Quad(vertices, edges);
+    recordAdded(quad);
+    return quad;
+}
+
+void Mesh::freeVertice(Vertice* v)
+{
+    if (!v) return;
+    recordRetired(v);
+    attributeTables.vertexNames.erase(v);
+    attributeTables.vertexColors.erase(v);
+    if (!vertexPool.owns(v))
+    {
+        delete v;
+        return;
+    }
+    v->~Vertice();
+    vertexPool.release(v);
+}
+
+void Mesh::reserve(size_t extraVertices, size_t extraEdges, size_t extraFaces)
+{
+    vertices.reserve(vertices.size() + extraVertices);
+    edges.reserve(edges.size() + extraEdges);
+    faces.reserve(faces.size() + extraFaces);
+    edgeIndex.reserve(edgeIndex.size() + extraEdges);
+}
+
+void Mesh::freeEdge(Edge* e)
+{
+    if (!e) return;
+    recordRetired(e);
+    attributeTables.edgeColors.erase(e);
+    if (!edgePool.owns(e))
+    {
+        delete e;
+        return;
+    }
+    e->~Edge();
+    edgePool.release(e);
+}
+
+void Mesh::freeFace(Face* f)
+{
+    if (!f) return;
+    recordRetired(f);
+    attributeTables.faceColors.erase(f);
+    attributeTables.faceTransforms.erase(f);
+    if (!facePool.owns(f))
+    {
+        delete f;
+        return;
+    }
+    f->~Face();
+    facePool.release(f);
+}
+
+const Mesh::Attributes& Mesh::defaultAttributes()
+{
+    static const Attributes none;
+    return none;
+}
+
+Mesh::MemoryReport Mesh::getMemoryReport() const
+{
+    MemoryReport report;
+    report.vertices = vertexPool.stats();
+    report.edges = edgePool.stats();
+    report.faces = facePool.stats();
+
+    for (const Vertice* v : vertices)
+    {
+        if (v) report.adjacencyBytes += v->getEdges().capacity() * sizeof(Edge*) + v->getFaces().capacity() * sizeof(Face*);
+    }
+    for (const Edge* e : edges)
+    {
+        if (e) report.adjacencyBytes += e->getSharedFaces().capacity() * sizeof(Face*);
+    }
+    for (const Face* f : faces)
+    {
+        if (f) report.adjacencyBytes += f->getVertices().capacity() * sizeof(Vertice*) + f->getEdges().capacity() * sizeof(Edge*);
+    }
+
+    report.attributeBytes = attributeTables.bytes();
+    return report;
+}
+
+// slabs go back to the heap in one go once nothing in them is alive; elements
+// detached for undo history keep their pool until the mesh itself is gone,
+// whose pools then destroy them
+void Mesh::releaseEmptyPools()
+{
+    if (vertexPool.liveCount() == 0) vertexPool.clear();
+    if (edgePool.liveCount() == 0) edgePool.clear();
+    if (facePool.liveCount() == 0) facePool.clear();
+}
+
 void Mesh::setMeshDNA(MeshDNA* dna, bool takeOwnership)
 {
     if (meshDNA && ownsDNA && meshDNA != dna)
@@ -169,71 +646,308 @@ void Mesh::setMeshDNA(MeshDNA* dna, bool takeOwnership)
 
 Vertice* Mesh::addVertice(const glm::vec3& localPos, const std::string& name)
 {
-    auto* v = new Vertice();
+    auto* v = createVertice();
     v->setLocalPosition(localPos);
-
-    const glm::vec4 world = getModelMatrix() * glm::vec4(localPos, 1.0f);
-    v->setPosition(glm::vec3(world));
-
     v->setMeshParent(this);
+    // unnamed vertices stay out of the name side table
     if (!name.empty())
         v->setName(name);
-    else
-        v->setName("Vertice_" + std::to_string(vertices.size()));
 
     vertices.push_back(v);
+    bumpTopologyVersion();
     return v;
 }
 
 Edge* Mesh::addEdge(Vertice* a, Vertice* b)
 {
     if (!a || !b) return nullptr;
-    auto* e = new Edge(a, b);
+    auto* e = createEdge(a, b);
+    e->setListSlot(static_cast<uint32_t>(edges.size()));
     edges.push_back(e);
+    indexEdge(e);
+    bumpTopologyVersion();
     return e;
 }
 
+void Mesh::addEdges(const std::vector<Vertice*>& ends, std::vector<Edge*>& out)
+{
+    const size_t count = ends.size() / 2;
+    out.resize(count);
+    edges.reserve(edges.size() + count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Edge* e = createEdge(ends[2 * i], ends[2 * i + 1]);
+        e->setListSlot(static_cast<uint32_t>(edges.size()));
+        edges.push_back(e);
+        out[i] = e;
+    }
+    edgeIndex.insertAll(out);
+    indexedEdgeCount += count;
+    bumpTopologyVersion();
+}
+
+// ---- edge index ---- //
+
+size_t Mesh::EdgeIndex::homeOf(const Vertice* a, const Vertice* b) const
+{
+    // symmetric in a and b, so either order finds the pair
+    const uint64_t pa = reinterpret_cast<uintptr_t>(a);
+    const uint64_t pb = reinterpret_cast<uintptr_t>(b);
+    return static_cast<size_t>(((pa + pb) * 0x9e3779b97f4a7c15ull ^ (pa ^ pb) * 0xc2b2ae3d27d4eb4full) >> shift);
+}
+
+size_t Mesh::EdgeIndex::slotOf(const Vertice* a, const Vertice* b) const
+{
+    const size_t mask = entries.size() - 1;
+    size_t h = homeOf(a, b);
+    while (entries[h].edge && !((entries[h].a == a && entries[h].b == b) || (entries[h].a == b && entries[h].b == a)))
+        h = (h + 1) & mask;
+    return h;
+}
+
+Edge* Mesh::EdgeIndex::find(const Vertice* a, const Vertice* b) const
+{
+    return entries.empty() ? nullptr : entries[slotOf(a, b)].edge;
+}
+
+void Mesh::EdgeIndex::insert(Edge* e)
+{
+    if ((used + 1) * 2 > entries.size())
+        rehash(std::max<size_t>(16, entries.size() * 2));
+
+    Entry& entry = entries[slotOf(e->getStart(), e->getEnd())];
+    if (entry.edge)
+        return;
+    entry = Entry{ e->getStart(), e->getEnd(), e };
+    ++used;
+}
+
+void Mesh::EdgeIndex::insertAll(const std::vector<Edge*>& batch)
+{
+    reserve(used + batch.size());
+
+    // a stable counting sort of the entries on the top bits of their home :
+    // a bucket's entries share a stretch of the table, the first edge of a
+    // pair stays first, and the edges themselves are read once, in list order
+    const int tableBits = 64 - shift;
+    const int bits = std::min(tableBits, 16);
+    std::vector<Entry> filed(batch.size());
+    std::vector<uint32_t> bucketOf(batch.size());
+    std::vector<uint32_t> start((size_t(1) << bits) + 1, 0);
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        filed[i] = Entry{ batch[i]->getStart(), batch[i]->getEnd(), batch[i] };
+        bucketOf[i] = static_cast<uint32_t>(homeOf(filed[i].a, filed[i].b) >> (tableBits - bits));
+        ++start[bucketOf[i] + 1];
+    }
+    for (size_t b = 1; b < start.size(); ++b)
+        start[b] += start[b - 1];
+
+    std::vector<Entry> ordered(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+        ordered[start[bucketOf[i]]++] = filed[i];
+
+    for (const Entry& entry : ordered)
+    {
+        Entry& slot = entries[slotOf(entry.a, entry.b)];
+        if (slot.edge)
+            continue;
+        slot = entry;
+        ++used;
+    }
+}
+
+void Mesh::EdgeIndex::erase(const Edge* e)
+{
+    if (entries.empty())
+        return;
+    size_t hole = slotOf(e->getStart(), e->getEnd());
+    if (entries[hole].edge != e)
+        return;
+
+    // pull back every later entry of the run that may sit in the hole
+    const size_t mask = entries.size() - 1;
+    for (size_t i = (hole + 1) & mask; entries[i].edge; i = (i + 1) & mask)
+    {
+        const size_t home = homeOf(entries[i].a, entries[i].b);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            entries[hole] = entries[i];
+            hole = i;
+        }
+    }
+    entries[hole] = Entry{};
+    --used;
+}
+
+void Mesh::EdgeIndex::reserve(size_t count)
+{
+    size_t capacity = 16;
+    while (capacity < count * 2)
+        capacity <<= 1;
+    if (capacity > entries.size())
+        rehash(capacity);
+}
+
+void Mesh::EdgeIndex::clear()
+{
+    std::vector<Entry>().swap(entries);
+    used = 0;
+    shift = 64;
+}
+
+void Mesh::EdgeIndex::rehash(size_t capacity)
+{
+    std::vector<Entry> old;
+    old.swap(entries);
+    entries.resize(capacity);
+    shift = 64;
+    for (size_t n = capacity; n > 1; n >>= 1)
+        --shift;
+
+    for (const Entry& e : old)
+    {
+        if (e.edge)
+            entries[slotOf(e.a, e.b)] = e;
+    }
+}
+
+void Mesh::indexEdge(Edge* e)
+{
+    // the first edge registered for a vertex pair keeps the slot
+    edgeIndex.insert(e);
+    ++indexedEdgeCount;
+}
+
+void Mesh::unindexEdge(Edge* e)
+{
+    edgeIndex.erase(e);
+    if (indexedEdgeCount > 0)
+        --indexedEdgeCount;
+}
+
+void Mesh::rebuildEdgeIndex() const
+{
+    std::vector<Edge*> filed;
+    filed.reserve(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        Edge* e = edges[i];
+        if (!e) continue;
+        e->setListSlot(static_cast<uint32_t>(i));
+        if (e->getStart() && e->getEnd())
+            filed.push_back(e);
+    }
+    edgeIndex.clear();
+    edgeIndex.insertAll(filed);
+    indexedEdgeCount = edges.size();
+}
+
+Edge* Mesh::findEdge(const Vertice* a, const Vertice* b) const
+{
+    if (!a || !b) return nullptr;
+
+    if (indexedEdgeCount != edges.size())
+        rebuildEdgeIndex();
+
+    return edgeIndex.find(a, b);
+}
+
+void Mesh::detachEdge(Edge* e)
+{
+    if (!e) return;
+
+    // edges pushed behind addEdge's back carry no valid slot, find them the slow way
+    size_t slot = e->getListSlot();
+    if (slot >= edges.size() || edges[slot] != e)
+    {
+        auto it = std::find(edges.begin(), edges.end(), e);
+        if (it == edges.end())
+            return;
+        slot = static_cast<size_t>(it - edges.begin());
+    }
+
+    // edge order carries no meaning, so the last edge fills the hole
+    Edge* last = edges.back();
+    edges[slot] = last;
+    if (last) last->setListSlot(static_cast<uint32_t>(slot));
+    edges.pop_back();
+    e->setListSlot(UINT32_MAX);
+
+    unindexEdge(e);
+    bumpTopologyVersion();
+}
+
 Face* Mesh::addFace(Vertice* v0, Vertice* v1, Vertice* v2, Vertice* v3,
 Edge* e0, Edge* e1, Edge* e2, Edge* e3)
 {
     if (!v0 || !v1 || !v2 || !v3) return nullptr;
 
-    auto* f = new Face(v0, v1, v2, v3, e0, e1, e2, e3);
+    auto* f = new (facePool.allocate()) Face(v0, v1, v2, v3, e0, e1, e2, e3);
+    recordAdded(f);
+    f->setParentMesh(this);
+    f->linkAdjacency();
     faces.push_back(f);
+    bumpTopologyVersion();
     return f;
 }
 
-std::vector<Quad*> Mesh::getQuads() const
+// ---- face buckets ---- //
+
+void Mesh::syncFaceBuckets() const
 {
-    std::vector<Quad*> quads;
+    if (bucketTopologyVersion == topologyVersion && bucketFaceCount == faces.size())
+        return;
+
+    quadBucket.clear();
+    triangleBucket.clear();
+    ngonBucket.clear();
     for (Face* f : faces)
     {
-        if (auto* q = dynamic_cast<Quad*>(f))
-            quads.push_back(q);
+        if (!f) continue;
+        switch (f->getKind())
+        {
+        case FaceKind::Quad:     quadBucket.push_back(static_cast<Quad*>(f)); break;
+        case FaceKind::Triangle: triangleBucket.push_back(static_cast<Triangle*>(f)); break;
+        case FaceKind::Ngon:     ngonBucket.push_back(static_cast<Ngon*>(f)); break;
+        case FaceKind::Generic:  break;
+        }
     }
-    return quads;
+
+    bucketTopologyVersion = topologyVersion;
+    bucketFaceCount = faces.size();
 }
 
-std::vector<Triangle*> Mesh::getTriangles() const
+const MeshLoops::Ring* Mesh::getEdgeRing(const Edge* e)
 {
-    std::vector<Triangle*> triangles;
-    for (Face* f : faces)
-    {
-        if (auto* t = dynamic_cast<Triangle*>(f))
-            triangles.push_back(t);
-    }
-    return triangles;
+    const MeshTopology& topo = getTopology();
+    const uint32_t handle = topo.handleOf(e);
+    return handle != MeshTopology::kInvalid ? &loops.ring(topo, handle) : nullptr;
 }
 
-std::vector<Ngon*> Mesh::getNgons() const
+const MeshLoops::Loop* Mesh::getEdgeLoop(const Edge* e)
 {
-    std::vector<Ngon*> ngons;
-    for (Face* f : faces)
-    {
-        if (auto* n = dynamic_cast<Ngon*>(f))
-            ngons.push_back(n);
-    }
-    return ngons;
+    const MeshTopology& topo = getTopology();
+    const uint32_t handle = topo.handleOf(e);
+    return handle != MeshTopology::kInvalid ? &loops.loop(topo, handle) : nullptr;
+}
+
+const std::vector<Quad*>& Mesh::getQuads() const
+{
+    syncFaceBuckets();
+    return quadBucket;
+}
+
+const std::vector<Triangle*>& Mesh::getTriangles() const
+{
+    syncFaceBuckets();
+    return triangleBucket;
+}
+
+const std::vector<Ngon*>& Mesh::getNgons() const
+{
+    syncFaceBuckets();
+    return ngonBucket;
 }
 
 
@@ -244,7 +958,6 @@ void Mesh::finalize()
     {
 
         v->setMeshParent(this);
-        v->setName("Vertice_" + std::to_string(&v - &vertices[0]));
         v->initialize();
     }
 
@@ -266,32 +979,31 @@ void Mesh::clearGeometry()
 {
     destroyVertices();
     destroyEdges();
+    releaseEmptyPools();
 }
 
 void Mesh::destroySelectedFaces(const std::vector<Face*>& facesToDestroy)
 {
-    for (Face* selectedFace : facesToDestroy)
+    std::unordered_set<Face*> doomed;
+    doomed.reserve(facesToDestroy.size());
+    for (Face* f : facesToDestroy)
     {
-        if (!selectedFace) continue;
-        
-        const auto& faceEdges = selectedFace->getEdges();
-        for (Edge* edge : faceEdges)
-        {
-            if (edge)
-            {
-                std::vector<Face*> currentSharedFaces = edge->getSharedFaces();
-                auto it = std::find(currentSharedFaces.begin(), currentSharedFaces.end(), selectedFace);
-                if (it != currentSharedFaces.end())
-                {
-                    currentSharedFaces.erase(it);
-                    edge->setSharedFaces(currentSharedFaces);
-                }
-            }
-        }
-        
+        if (f) doomed.insert(f);
+    }
+    if (doomed.empty())
+        return;
+
+    // one pass over the face list instead of a find + erase per face
+    faces.erase(std::remove_if(faces.begin(), faces.end(),
+        [&](Face* f) { return doomed.count(f) != 0; }), faces.end());
+
+    for (Face* selectedFace : doomed)
+    {
+        selectedFace->unlinkAdjacency();
         selectedFace->destroy();
-        delete selectedFace;
+        freeFace(selectedFace);
     }
+    bumpTopologyVersion();
     
     destroyOrphanEdges();
     destroyOrphanVertices();
@@ -301,46 +1013,482 @@ void Mesh::destroySelectedFaces(const std::vector<Face*>& facesToDestroy)
 
 void Mesh::destroyOrphanEdges()
 {
-    auto& meshEdges = getEdgesNonConst();
-    for (auto it = meshEdges.begin(); it != meshEdges.end();)
+    size_t destroyed = 0;
+    size_t write = 0;
+    for (size_t read = 0; read < edges.size(); ++read)
     {
-        Edge* edge = *it;
+        Edge* edge = edges[read];
         if (edge && edge->getSharedFaces().empty())
         {
             if (edge->getStart())
                 edge->getStart()->removeEdge(edge);
             if (edge->getEnd())
                 edge->getEnd()->removeEdge(edge);
-            
+            unindexEdge(edge);
+
             edge->destroy();
-            delete edge;
-            it = meshEdges.erase(it);
-            std::cout << "[Mesh] Edge with empty sharedFaces destroyed" << std::endl;
-        }
-        else
-        {
-            ++it;
+            freeEdge(edge);
+            ++destroyed;
+            continue;
         }
+
+        if (edge) edge->setListSlot(static_cast<uint32_t>(write));
+        edges[write++] = edge;
+    }
+    edges.resize(write);
+
+    if (destroyed > 0)
+    {
+        bumpTopologyVersion();
+        std::cout << "[Mesh] " << destroyed << " edge(s) with empty sharedFaces destroyed" << std::endl;
     }
 }
 
 void Mesh::destroyOrphanVertices()
 {
-    auto& meshVertices = vertices;
-    for (auto it = meshVertices.begin(); it != meshVertices.end();)
+    size_t destroyed = 0;
+    size_t write = 0;
+    for (size_t read = 0; read < vertices.size(); ++read)
     {
-        Vertice* vertice = *it;
+        Vertice* vertice = vertices[read];
         if (vertice && vertice->getEdges().empty())
         {
             vertice->destroy();
-            delete vertice;
-            it = meshVertices.erase(it);
-            std::cout << "[Mesh] Vertice with no edges destroyed" << std::endl;
+            freeVertice(vertice);
+            ++destroyed;
+            continue;
+        }
+        vertices[write++] = vertice;
+    }
+    vertices.resize(write);
+
+    if (destroyed > 0)
+    {
+        bumpTopologyVersion();
+        std::cout << "[Mesh] " << destroyed << " vertice(s) with no edges destroyed" << std::endl;
+    }
+}
+
+// ---- weld ---- //
+
+namespace
+{
+    constexpr uint32_t kWeldEmpty = UINT32_MAX;
+
+    // uniform grid over vertex positions, stored as an open-addressing table of
+    // occupied cells; each cell heads a chain of vertex indices threaded through next.
+    // Cells are twice the tolerance wide, so a vertex is within reach of at most
+    // one neighbour per axis
+    class WeldGrid
+    {
+    public:
+        WeldGrid(size_t count, float cellSize) : inverse(1.0f / cellSize), next(count, kWeldEmpty)
+        {
+            size_t capacity = 16;
+            while (capacity < count * 2)
+                capacity <<= 1;
+            cells.resize(capacity);
+            mask = capacity - 1;
+        }
+
+        glm::ivec3 cellOf(const glm::vec3& p) const
+        {
+            // far-off points share the outermost cells rather than overflow
+            const glm::vec3 c = glm::clamp(glm::floor(p * inverse), glm::vec3(-1e9f), glm::vec3(1e9f));
+            return glm::ivec3(c);
+        }
+
+        void insert(uint32_t v, const glm::ivec3& c)
+        {
+            Cell& cell = cells[slotOf(c)];
+            cell.key = c;
+            next[v] = cell.head;
+            cell.head = v;
+        }
+
+        // -1 or +1 per axis : the half of its cell p lies in
+        glm::ivec3 sideOf(const glm::vec3& p) const
+        {
+            const glm::vec3 s = p * inverse;
+            const glm::vec3 f = s - glm::floor(s);
+            return glm::ivec3(f.x < 0.5f ? -1 : 1, f.y < 0.5f ? -1 : 1, f.z < 0.5f ? -1 : 1);
+        }
+
+        uint32_t head(const glm::ivec3& c) const { return cells[slotOf(c)].head; }
+        uint32_t nextOf(uint32_t v) const { return next[v]; }
+
+    private:
+        struct Cell
+        {
+            glm::ivec3 key{ 0 };
+            uint32_t head = kWeldEmpty;
+        };
+
+        // the cell holding c, or the empty one it would go in
+        size_t slotOf(const glm::ivec3& c) const
+        {
+            size_t h = (uint32_t(c.x) * 73856093u) ^ (uint32_t(c.y) * 19349663u) ^ (uint32_t(c.z) * 83492791u);
+            h = (h ^ (h >> 13)) & mask;
+            while (cells[h].head != kWeldEmpty && cells[h].key != c)
+                h = (h + 1) & mask;
+            return h;
+        }
+
+        float inverse;
+        size_t mask = 0;
+        std::vector<Cell> cells;
+        std::vector<uint32_t> next;
+    };
+
+    // vertex pair -> edge list position, keyed on the welded vertex indices
+    class WeldEdgeTable
+    {
+    public:
+        explicit WeldEdgeTable(size_t count)
+        {
+            size_t capacity = 16;
+            while (capacity < count * 2)
+                capacity <<= 1;
+            keys.resize(capacity);
+            values.assign(capacity, kWeldEmpty);
+            mask = capacity - 1;
+        }
+
+        static uint64_t keyOf(uint32_t a, uint32_t b)
+        {
+            return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+        }
+
+        // the edge already filed under key, or kWeldEmpty after filing value there
+        uint32_t insert(uint64_t key, uint32_t value)
+        {
+            const size_t h = slotOf(key);
+            if (values[h] != kWeldEmpty)
+                return values[h];
+            keys[h] = key;
+            values[h] = value;
+            return kWeldEmpty;
+        }
+
+        uint32_t find(uint64_t key) const { return values[slotOf(key)]; }
+
+    private:
+        size_t slotOf(uint64_t key) const
+        {
+            size_t h = static_cast<size_t>((key * 0x9e3779b97f4a7c15ull) >> 20) & mask;
+            while (values[h] != kWeldEmpty && keys[h] != key)
+                h = (h + 1) & mask;
+            return h;
         }
+
+        size_t mask = 0;
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> values;
+    };
+}
+
+size_t Mesh::weldByDistance(float tolerance)
+{
+    if (tolerance < 0.0f)
+        return 0;
+
+    // ---- dense vertex indices ---- //
+    // kept in a table keyed by pool slot, the vertices' topology slots belong
+    // to MeshTopology; vertices from outside the pool go in a side map
+    std::vector<Vertice*> verts;
+    verts.reserve(vertices.size());
+    std::vector<uint32_t> slotIndex(vertexPool.slotCount(), kWeldEmpty);
+    std::unordered_map<const Vertice*, uint32_t> strayIndex;
+    for (Vertice* v : vertices)
+    {
+        if (!v) continue;
+        const uint32_t index = static_cast<uint32_t>(verts.size());
+        const size_t slot = vertexPool.slotIndexOf(v);
+        if (slot < slotIndex.size())
+            slotIndex[slot] = index;
         else
+            strayIndex.emplace(v, index);
+        verts.push_back(v);
+    }
+    const uint32_t count = static_cast<uint32_t>(verts.size());
+    if (count < 2)
+        return 0;
+
+    std::vector<glm::vec3> positions(count);
+    std::vector<glm::ivec3> cells(count);
+    WeldGrid grid(count, 2.0f * std::max(tolerance, 1e-6f));
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        positions[i] = verts[i]->getLocalPosition();
+        cells[i] = grid.cellOf(positions[i]);
+        grid.insert(i, cells[i]);
+    }
+
+    // ---- clusters : union-find, the lowest index of a cluster stays ---- //
+    std::vector<uint32_t> parent(count);
+    for (uint32_t i = 0; i < count; ++i)
+        parent[i] = i;
+
+    auto root = [&](uint32_t v)
+    {
+        while (parent[v] != v)
         {
-            ++it;
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+
+    const float limit = tolerance * tolerance;
+    auto tryMerge = [&](uint32_t a, uint32_t b)
+    {
+        const glm::vec3 d = positions[a] - positions[b];
+        if (glm::dot(d, d) > limit) return;
+
+        const uint32_t ra = root(a);
+        const uint32_t rb = root(b);
+        if (ra == rb) return;
+        if (ra < rb) parent[rb] = ra;
+        else parent[ra] = rb;
+    };
+
+    // the cell itself plus the 13 neighbours ahead of it, so each pair is tested once;
+    // of those only the ones on the vertex's side of its cell can hold a match
+    glm::ivec3 forward[13];
+    int forwardCount = 0;
+    for (int dz = 0; dz <= 1; ++dz)
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                if (dz == 0 && (dy < 0 || (dy == 0 && dx <= 0))) continue;
+                forward[forwardCount++] = glm::ivec3(dx, dy, dz);
+            }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // vertices inserted into this cell before i
+        for (uint32_t j = grid.nextOf(i); j != kWeldEmpty; j = grid.nextOf(j))
+            tryMerge(i, j);
+        const glm::ivec3 side = grid.sideOf(positions[i]);
+        for (const glm::ivec3& offset : forward)
+        {
+            if ((offset.x != 0 && offset.x != side.x) || (offset.y != 0 && offset.y != side.y)
+                || (offset.z != 0 && offset.z != side.z))
+                continue;
+            for (uint32_t j = grid.head(cells[i] + offset); j != kWeldEmpty; j = grid.nextOf(j))
+                tryMerge(i, j);
         }
     }
-}
 
+    size_t merged = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        parent[i] = root(i);
+        merged += parent[i] != i;
+    }
+    if (merged == 0)
+        return 0;
+
+    // welded index of v, kWeldEmpty for vertices outside the list
+    auto indexOf = [&](const Vertice* v)
+    {
+        if (!v) return kWeldEmpty;
+        uint32_t index = kWeldEmpty;
+        const size_t slot = vertexPool.slotIndexOf(v);
+        if (slot < slotIndex.size())
+            index = slotIndex[slot];
+        else if (!strayIndex.empty())
+        {
+            const auto it = strayIndex.find(v);
+            if (it != strayIndex.end()) index = it->second;
+        }
+        return index != kWeldEmpty ? parent[index] : kWeldEmpty;
+    };
+
+    beginEdit();
+    // every merged vertex is retired, edges and faces are recorded at most once each
+    reserveRecord(merged, edges.size(), faces.size(), 4 * faces.size());
+
+    // ---- edges : rewired in place, collapsed and duplicate ones retired ---- //
+    // edges left alone claim their vertex pair first
+    WeldEdgeTable pairs(edges.size());
+    std::vector<char> moved(edges.size(), 0);
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        Edge* e = edges[i];
+        if (!e) continue;
+        e->setListSlot(static_cast<uint32_t>(i));
+        const uint32_t a = indexOf(e->getStart());
+        const uint32_t b = indexOf(e->getEnd());
+        if (a == kWeldEmpty || b == kWeldEmpty) continue;
+
+        if (verts[a] != e->getStart() || verts[b] != e->getEnd())
+            moved[i] = 1;
+        else
+            pairs.insert(WeldEdgeTable::keyOf(a, b), static_cast<uint32_t>(i));
+    }
+
+    std::vector<char> retired(edges.size(), 0);
+    size_t retiredCount = 0;
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        if (!moved[i]) continue;
+        Edge* e = edges[i];
+        const uint32_t a = indexOf(e->getStart());
+        const uint32_t b = indexOf(e->getEnd());
+        if (a == b || pairs.insert(WeldEdgeTable::keyOf(a, b), static_cast<uint32_t>(i)) != kWeldEmpty)
+        {
+            retired[i] = 1;
+            ++retiredCount;
+            continue;
+        }
+
+        recordBefore(e);
+        if (verts[a] != e->getStart()) verts[a]->addEdge(e);
+        if (verts[b] != e->getEnd()) verts[b]->addEdge(e);
+        e->rewire(verts[a], verts[b]);
+    }
+
+    // ---- faces over merged vertices ---- //
+    // same corner count : rewired in place; fewer : rebuilt as the smaller kind; under 3 : dropped
+    // welded holds the index of each corner, looked up once per face
+    std::vector<uint32_t> welded;
+    std::vector<Vertice*> corners;
+    std::vector<Edge*> sides;
+    size_t droppedFaces = 0;
+    for (Face*& f : faces)
+    {
+        if (!f) continue;
+        const auto& vs = f->getVertices();
+        bool touched = false;
+        welded.clear();
+        for (const Vertice* v : vs)
+        {
+            const uint32_t index = indexOf(v);
+            welded.push_back(index);
+            touched = touched || (index != kWeldEmpty && verts[index] != v);
+        }
+        if (!touched) continue;
+
+        recordBefore(f);
+        // merged-away corners and retired sides go below, only the kept ones let go of f
+        for (size_t i = 0; i < vs.size(); ++i)
+        {
+            if (vs[i] && (welded[i] == kWeldEmpty || verts[welded[i]] == vs[i]))
+                vs[i]->removeFace(f);
+        }
+        for (Edge* e : f->getEdges())
+        {
+            const size_t slot = e ? e->getListSlot() : 0;
+            if (e && !(slot < edges.size() && edges[slot] == e && retired[slot]))
+                e->removeSharedFace(f);
+        }
+
+        corners.clear();
+        for (size_t i = 0; i < vs.size(); ++i)
+        {
+            Vertice* m = welded[i] != kWeldEmpty ? verts[welded[i]] : vs[i];
+            if (corners.empty() || corners.back() != m)
+            {
+                welded[corners.size()] = welded[i];
+                corners.push_back(m);
+            }
+        }
+        while (corners.size() > 1 && corners.front() == corners.back())
+            corners.pop_back();
+
+        // a corner met twice would pinch the polygon, drop it with the slivers
+        bool degenerate = corners.size() < 3;
+        for (size_t i = 0; i < corners.size() && !degenerate; ++i)
+            degenerate = std::find(corners.begin() + i + 1, corners.end(), corners[i]) != corners.end();
+
+        if (degenerate)
+        {
+            f->destroy();
+            freeFace(f);
+            f = nullptr;
+            ++droppedFaces;
+            continue;
+        }
+
+        const size_t n = corners.size();
+        sides.clear();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint32_t a = welded[i];
+            const uint32_t b = welded[(i + 1) % n];
+            const uint32_t slot = a != kWeldEmpty && b != kWeldEmpty ? pairs.find(WeldEdgeTable::keyOf(a, b)) : kWeldEmpty;
+            sides.push_back(slot != kWeldEmpty ? edges[slot] : nullptr);
+        }
+
+        if (n == vs.size())
+        {
+            f->rewire(corners, sides);
+            f->linkAdjacency();
+            continue;
+        }
+
+        Face* rebuilt = nullptr;
+        if (n == 4)
+            rebuilt = createQuad({ corners[0], corners[1], corners[2], corners[3] }, { sides[0], sides[1], sides[2], sides[3] });
+        else if (n == 3)
+            rebuilt = new (facePool.allocate()) Triangle(corners[0], corners[1], corners[2], sides[0], sides[1], sides[2]);
+        else
+            rebuilt = new (facePool.allocate()) Ngon(corners, sides);
+        recordAdded(rebuilt);
+        rebuilt->setParentMesh(this);
+        if (f->getColor() != rebuilt->getColor())
+            rebuilt->setColor(f->getColor());
+        rebuilt->linkAdjacency();
+
+        f->destroy();
+        freeFace(f);
+        f = rebuilt;
+    }
+    if (droppedFaces > 0)
+        faces.erase(std::remove(faces.begin(), faces.end(), nullptr), faces.end());
+
+    // ---- retired edges leave in one compaction pass ---- //
+    size_t write = 0;
+    for (size_t read = 0; read < edges.size(); ++read)
+    {
+        Edge* e = edges[read];
+        if (retired[read])
+        {
+            // merged-away endpoints go below, only the kept ones need unhooking
+            const uint32_t a = indexOf(e->getStart());
+            const uint32_t b = indexOf(e->getEnd());
+            if (a != kWeldEmpty && verts[a] == e->getStart())
+                e->getStart()->removeEdge(e);
+            if (b != kWeldEmpty && verts[b] == e->getEnd())
+                e->getEnd()->removeEdge(e);
+            e->destroy();
+            freeEdge(e);
+            continue;
+        }
+        if (e) e->setListSlot(static_cast<uint32_t>(write));
+        edges[write++] = e;
+    }
+    edges.resize(write);
+
+    // most keys moved, so the edge index is rebuilt on the next lookup
+    edgeIndex.clear();
+    indexedEdgeCount = 0;
+
+    // ---- merged vertices ---- //
+    vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
+        [&](Vertice* v) { return v && verts[indexOf(v)] != v; }), vertices.end());
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (parent[i] == i) continue;
+        verts[i]->destroy();
+        freeVertice(verts[i]);
+    }
+
+    bumpTopologyVersion();
+    commitEdit("weld");
+
+    std::cout << "[Mesh] Weld merged " << merged << " vertice(s), retired " << retiredCount
+        << " edge(s), dropped " << droppedFaces << " face(s)" << std::endl;
+    return merged;
+}
@@ -8,10 +8,20 @@
 #include "WorldObjects/Basic/Quad.hpp"
 #include "WorldObjects/Basic/Triangle.hpp"
 #include "WorldObjects/Basic/Ngon.hpp"
+#include "WorldObjects/Basic/ElementAttribute.hpp"
 #include "WorldObjects/Mesh_DNA/Mesh_DNA.hpp"
+#include "WorldObjects/Mesh/MeshRenderCache.hpp"
+#include "WorldObjects/Mesh/MeshBVH.hpp"
+#include "WorldObjects/Mesh/MeshTopology.hpp"
+#include "WorldObjects/Mesh/MeshLoops.hpp"
+#include "WorldObjects/Mesh/MeshSubdivision.hpp"
+#include "WorldObjects/Mesh/ElementPool.hpp"
+#include "WorldObjects/Mesh/ElementRef.hpp"
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <algorithm>
 
 namespace WorldObjects { namespace MeshNS {} }
 
@@ -32,6 +42,10 @@ public:
 
     Vertice* addVertice(const glm::vec3& localPos, const std::string& name = {});
     Edge* addEdge(Vertice* a, Vertice* b);
+    // addEdge for every pair in ends (two per edge, none null), written to out.
+    // The batch is filed in the edge index in table order, which keeps the
+    // probes of an operator adding millions of edges from missing cache each time
+    void addEdges(const std::vector<Vertice*>& ends, std::vector<Edge*>& out);
     Face* addFace(Vertice* v0, Vertice* v1, Vertice* v2, Vertice* v3,
     Edge* e0 = nullptr, Edge* e1 = nullptr, Edge* e2 = nullptr, Edge* e3 = nullptr);
 
@@ -39,16 +53,96 @@ public:
     Triangle* addTriangle(Vertice* v0, Vertice* v1, Vertice* v2, Edge* e0 = nullptr, Edge* e1 = nullptr, Edge* e2 = nullptr);
     Ngon* addNgon(const std::vector<Vertice*>& vertices, const std::vector<Edge*>& edges);
 
+    // edge joining a and b in either direction, nullptr when there is none
+    Edge* findEdge(const Vertice* a, const Vertice* b) const;
+    // takes e out of the edge list and index without destroying it
+    void detachEdge(Edge* e);
+
+    // pool-backed elements that are not put in the element lists yet, for
+    // operators that insert them themselves
+    Vertice* createVertice();
+    Edge* createEdge(Vertice* a, Vertice* b);
+    Quad* createQuad(const std::array<Vertice*, 4>& vertices, const std::array<Edge*, 4>& edges);
+
+    // grows the element lists ahead of an operator that knows how much it adds
+    void reserve(size_t extraVertices, size_t extraEdges, size_t extraFaces);
+
+    // destroy an element's storage; elements not allocated by this mesh are deleted
+    void freeVertice(Vertice* v);
+    void freeEdge(Edge* e);
+    void freeFace(Face* f);
+
+    // ---- side tables ---- //
+    // names, colors and face transforms that few elements ever change live out
+    // of line, in tables owned by the mesh : they go with it and count in its report
+    struct Attributes
+    {
+        ElementAttribute<Vertice, std::string> vertexNames{ std::string() };
+        ElementAttribute<Vertice, glm::vec4> vertexColors{ glm::vec4(0.0f, 1.0f, 0.0f, 1.0f) };
+        ElementAttribute<Edge, glm::vec4> edgeColors{ glm::vec4(0.0f, 0.0f, 0.0f, 1.0f) };
+        ElementAttribute<Face, glm::vec4> faceColors{ glm::vec4(1.0f) };
+        ElementAttribute<Face, glm::mat4> faceTransforms{ glm::mat4(1.0f) };
+
+        size_t bytes() const
+        {
+            return vertexNames.bytes() + vertexColors.bytes() + edgeColors.bytes() + faceColors.bytes() + faceTransforms.bytes();
+        }
+    };
+    Attributes& attributes() { return attributeTables; }
+    const Attributes& attributes() const { return attributeTables; }
+    // empty tables, read by elements that are not in a mesh
+    static const Attributes& defaultAttributes();
+
+    // A vertex record is 96 B on 64-bit builds against a 16-32 B target.
+    // Half of it is the two adjacency vectors, the face list included so
+    // face lookups from a vertex are O(1); a packed layout would need index
+    // arrays instead of the pointer graph every operator walks. Their heap
+    // is counted apart, in adjacencyBytes.
+    static constexpr size_t kVertexRecordBytes = sizeof(Vertice);
+
+    struct MemoryReport
+    {
+        ElementPool::Stats vertices;
+        ElementPool::Stats edges;
+        ElementPool::Stats faces;
+        size_t adjacencyBytes = 0;   // heap behind the per-element edge / face lists
+        size_t attributeBytes = 0;   // this mesh's name / color / transform side tables
+
+        size_t totalBytes() const { return vertices.bytesLive + edges.bytesLive + faces.bytesLive + adjacencyBytes + attributeBytes; }
+    };
+    MemoryReport getMemoryReport() const;
+
+    // ---- generation-checked references ---- //
+    // stamp an element so a later resolve() notices it was freed or its slot reused
+    template <typename T>
+    ElementRef<T> makeRef(T* element) const { return ElementRef<T>(element, generationOf(element)); }
+
+    // the element while it is still the one the ref was made for, nullptr otherwise
+    template <typename T>
+    T* resolve(const ElementRef<T>& ref) const
+    {
+        if (!ref.get() || ref.generation() == 0)
+            return ref.get();
+        return generationOf(ref.get()) == ref.generation() ? ref.get() : nullptr;
+    }
+
+    uint32_t generationOf(const Vertice* v) const { return vertexPool.generationOf(v); }
+    uint32_t generationOf(const Edge* e) const { return edgePool.generationOf(e); }
+    uint32_t generationOf(const Face* f) const { return facePool.generationOf(f); }
+
     void finalize();
 
     const std::vector<Vertice*>& getVertices() const { return vertices; }
     const std::vector<Edge*>& getEdges() const { return edges; }
     const std::vector<Face*>& getFaces() const { return faces; }
-    std::vector<Face*>& getFacesNonConst() { return faces; }
+    // callers of the non-const accessors edit topology in place
+    std::vector<Face*>& getFacesNonConst() { bumpTopologyVersion(); return faces; }
 
-    std::vector<Quad*> getQuads() const;
-    std::vector<Triangle*> getTriangles() const;
-    std::vector<Ngon*> getNgons() const;
+    // per-kind views over the face list, rebuilt lazily after topology edits;
+    // the references stay valid until the next edit
+    const std::vector<Quad*>& getQuads() const;
+    const std::vector<Triangle*>& getTriangles() const;
+    const std::vector<Ngon*>& getNgons() const;
 
     bool hasTopology() const { return !vertices.empty() || !edges.empty() || !faces.empty(); }
     size_t vertexCount() const { return vertices.size(); }
@@ -59,17 +153,189 @@ public:
     void destroyOrphanVertices();
     void destroySelectedFaces(const std::vector<Face*>& facesToDestroy);
 
+    // merges vertices closer than tolerance into the first of each cluster and
+    // drops the edges and faces that collapse; returns how many vertices went away
+    size_t weldByDistance(float tolerance);
+
     void clearGeometry();
-    std::vector<Edge*>& getEdgesNonConst() { return edges; }
+    std::vector<Edge*>& getEdgesNonConst() { bumpTopologyVersion(); return edges; }
+
+    uint64_t getTopologyVersion() const { return topologyVersion; }
+    void bumpTopologyVersion()
+    {
+        ++topologyVersion;
+        boundsDirty = true;
+        if (editDepth > 0) { editChanged = true; return; }
+        bumpBoundsVersion();
+    }
+
+    // ---- edit transactions ---- //
+    // Operators bracket a batch of element edits with beginEdit / commitEdit.
+    // Inside, scene revision bumps are held back and no history is written;
+    // the outermost commit publishes the change once and records a single
+    // topology event in the MeshDNA, or none when the tag is empty.
+    // Transactions nest.
+    void beginEdit();
+    void commitEdit(const std::string& tag);
+    bool isEditing() const { return editDepth > 0; }
+
+    // Puts back what one recorded transaction changed : its new elements go,
+    // the ones it moved, rewired or retired return as they were. Called by
+    // MeshDNA::rewindComponentHistory, newest record first; retired elements
+    // come back as copies, listed in revived when given.
+    void revertTopologyEdit(const TopologyEditRecord& rec, RevivedElements* revived = nullptr);
+
+    // called by Vertice::setLocalPosition inside an edit, before the move
+    void recordVerticeMove(Vertice* v) { recordBefore(v); }
+
+    // called by Vertice::setLocalPosition so only moved vertices get re-uploaded
+    void markVerticeDirty(uint32_t renderSlot, const glm::vec3& localPos);
+
+    bool getLocalBounds(glm::vec3& outMin, glm::vec3& outMax) const override;
+
+    // called by element setSelected / setColor so state buffers refresh lazily
+    void markElementStateDirty(PickTarget kind, bool colorsChanged) { renderCache.markStateDirty(kind, colorsChanged); }
+    // index is the draw-order index from the pick pass (PickHit::elementIndex)
+    void setHoveredElement(PickTarget kind, uint32_t index)
+    {
+        if (renderCache.setHovered(kind, index))
+            SceneRevision::bump();
+    }
+
+    void renderPick(PickTarget target, uint32_t objectId) { renderCache.renderPick(*this, getModelMatrix(), target, objectId); }
+    const MeshRenderCache& getRenderCache() const { return renderCache; }
+
+    // local-space picking structure, synced with the mesh on each query
+    MeshBVH& getBVH() { return bvh; }
+
+    // indexed half-edge view, rebuilt lazily after topology edits
+    const MeshTopology& getTopology() { topology.sync(*this); return topology; }
+
+    // edge ring / edge loop through an edge, memoized until the topology changes;
+    // nullptr when the edge is not part of the mesh
+    const MeshLoops::Ring* getEdgeRing(const Edge* e);
+    const MeshLoops::Loop* getEdgeLoop(const Edge* e);
+
+    // Catmull-Clark cage of the current mesh, kept until it is edited again;
+    // MeshEdit::Subdivide applies it to the mesh itself
+    const MeshSubdivision::Cage& getSubdivisionPreview(int levels) { return subdivision.preview(getTopology(), levels); }
 
 private:
     std::vector<Vertice*> vertices;
     std::vector<Edge*> edges;
     std::vector<Face*> faces;
 
+    // ---- (vertex, vertex) -> edge index ---- //
+    // Kept in step by addEdge / detachEdge / destroyOrphanEdges; rebuilt on
+    // the next lookup when the edge list was edited behind the mesh's back,
+    // or after weldByDistance moved most of its keys.
+    // Open addressing over one array with linear probing; erase shifts the
+    // rest of the run back, so there are no tombstones. Pairs are unordered.
+    class EdgeIndex
+    {
+    public:
+        Edge* find(const Vertice* a, const Vertice* b) const;
+        // the first edge filed for a vertex pair keeps it
+        void insert(Edge* e);
+        // insert for each edge of batch, in the order their entries sit in the table
+        void insertAll(const std::vector<Edge*>& batch);
+        // drops e's pair, when e is the edge filed under it
+        void erase(const Edge* e);
+        void reserve(size_t count);
+        // drops every entry along with the storage
+        void clear();
+        size_t size() const { return used; }
+
+    private:
+        struct Entry
+        {
+            const Vertice* a = nullptr;
+            const Vertice* b = nullptr;
+            Edge* edge = nullptr;  // nullptr for an empty entry
+        };
+        std::vector<Entry> entries;
+        size_t used = 0;
+        int shift = 64;
+        size_t homeOf(const Vertice* a, const Vertice* b) const;
+        size_t slotOf(const Vertice* a, const Vertice* b) const;  // the pair's entry, or the empty one it would go in
+        void rehash(size_t capacity);
+    };
+
+    mutable EdgeIndex edgeIndex;
+    mutable size_t indexedEdgeCount = 0;
+    void indexEdge(Edge* e);
+    void unindexEdge(Edge* e);
+    void rebuildEdgeIndex() const;
+
+    // ---- faces bucketed by FaceKind ---- //
+    mutable std::vector<Quad*> quadBucket;
+    mutable std::vector<Triangle*> triangleBucket;
+    mutable std::vector<Ngon*> ngonBucket;
+    mutable uint64_t bucketTopologyVersion = UINT64_MAX;
+    mutable size_t bucketFaceCount = 0;
+    void syncFaceBuckets() const;
+
+    // ---- element storage ---- //
+    // one face slot fits any face type so Quad / Triangle / Ngon share a pool
+    static constexpr size_t kFaceSlotSize = std::max({ sizeof(Face), sizeof(Quad), sizeof(Triangle), sizeof(Ngon) });
+    static constexpr size_t kFaceSlotAlign = std::max({ alignof(Face), alignof(Quad), alignof(Triangle), alignof(Ngon) });
+
+    // elements still detached when the mesh goes (undo history) are destroyed with their pool
+    ElementPool vertexPool{ sizeof(Vertice), alignof(Vertice), [](void* p) { static_cast<Vertice*>(p)->~Vertice(); } };
+    ElementPool edgePool{ sizeof(Edge), alignof(Edge), [](void* p) { static_cast<Edge*>(p)->~Edge(); } };
+    ElementPool facePool{ kFaceSlotSize, kFaceSlotAlign, [](void* p) { static_cast<Face*>(p)->~Face(); } };
+
+    Attributes attributeTables;
+
     MeshDNA* meshDNA = nullptr;
     bool ownsDNA = true;
 
+    MeshRenderCache renderCache;
+    MeshBVH bvh;
+    MeshTopology topology;
+    MeshLoops loops;
+    MeshSubdivision subdivision;
+    uint64_t topologyVersion = 0;
+
+    int editDepth = 0;
+    bool editChanged = false;
+    uint64_t editStartVersion = 0;
+    size_t editStartVertices = 0;
+    size_t editStartEdges = 0;
+    size_t editStartFaces = 0;
+
+    // ---- what the open transaction changed, for its history record ---- //
+    // Kept only when the mesh has a MeshDNA. Each element is recorded once :
+    // as made by the edit, or as it was the first time the edit touched it.
+    bool recording = false;
+    TopologyEditRecord editRecord;
+
+    // An element's mark is its entry in editRecord, kMadeInEdit for one the
+    // edit made, ElementPool::kNoMark while untouched. Pooled elements keep it
+    // in their slot, the odd element from outside the pools in strayMarks
+    static constexpr uint32_t kMadeInEdit = ElementPool::kNoMark - 1;
+    std::unordered_map<const void*, uint32_t> strayMarks;
+    uint32_t& editMark(ElementPool& pool, const void* element);
+    void recordAdded(Vertice* v);
+    void recordAdded(Edge* e);
+    void recordAdded(Face* f);
+    void recordBefore(Vertice* v);
+    void recordBefore(Edge* e);
+    void recordBefore(Face* f);
+    void recordRetired(Vertice* v);
+    void recordRetired(Edge* e);
+    void recordRetired(Face* f);
+    // room for the before-images of an edit that knows its size up front
+    void reserveRecord(size_t verts, size_t edges, size_t faces, size_t corners);
+    void stopRecording();
+
+    // grown when a vertex moves, recomputed from scratch after topology edits
+    mutable glm::vec3 boundsMin = glm::vec3(0.0f);
+    mutable glm::vec3 boundsMax = glm::vec3(0.0f);
+    mutable bool boundsDirty = true;
+    void recomputeBounds() const;
+
+    void releaseEmptyPools();
     void destroyVertices();
     void destroyEdges();
     void destroyFaces();
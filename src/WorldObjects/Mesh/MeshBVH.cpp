@@ -0,0 +1,311 @@
+#include "WorldObjects/Mesh/MeshBVH.hpp"
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include <algorithm>
+#include <limits>
+
+static constexpr uint32_t kLeafSize = 4;
+
+// ---- tree ---- //
+
+void MeshBVH::Tree::build(const std::vector<glm::vec3>& itemMin, const std::vector<glm::vec3>& itemMax)
+{
+    const uint32_t count = static_cast<uint32_t>(itemMin.size());
+
+    nodes.clear();
+    order.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+        order[i] = i;
+
+    if (count == 0)
+        return;
+
+    std::vector<glm::vec3> centroids(count);
+    for (uint32_t i = 0; i < count; ++i)
+        centroids[i] = (itemMin[i] + itemMax[i]) * 0.5f;
+
+    nodes.reserve(2 * (count / kLeafSize) + 1);
+    nodes.emplace_back();
+    buildNode(0, 0, count, itemMin, itemMax, centroids);
+}
+
+void MeshBVH::Tree::buildNode(uint32_t index, uint32_t begin, uint32_t end, const std::vector<glm::vec3>& itemMin,
+    const std::vector<glm::vec3>& itemMax, const std::vector<glm::vec3>& centroids)
+{
+    glm::vec3 bmin(std::numeric_limits<float>::max());
+    glm::vec3 bmax(-std::numeric_limits<float>::max());
+    glm::vec3 cmin = bmin, cmax = bmax;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const uint32_t item = order[i];
+        bmin = glm::min(bmin, itemMin[item]);
+        bmax = glm::max(bmax, itemMax[item]);
+        cmin = glm::min(cmin, centroids[item]);
+        cmax = glm::max(cmax, centroids[item]);
+    }
+    nodes[index].bmin = bmin;
+    nodes[index].bmax = bmax;
+
+    if (end - begin <= kLeafSize)
+    {
+        nodes[index].first = begin;
+        nodes[index].count = end - begin;
+        return;
+    }
+
+    // median split along the widest centroid axis
+    const glm::vec3 extent = cmax - cmin;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    const uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+        [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+
+    // children always sit after their parent, which refit relies on
+    const uint32_t left = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.emplace_back();
+    nodes[index].first = left;
+    nodes[index].count = 0;
+
+    buildNode(left, begin, mid, itemMin, itemMax, centroids);
+    buildNode(left + 1, mid, end, itemMin, itemMax, centroids);
+}
+
+void MeshBVH::Tree::refit(const std::vector<glm::vec3>& itemMin, const std::vector<glm::vec3>& itemMax)
+{
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        Node& node = nodes[i];
+        if (node.count > 0)
+        {
+            glm::vec3 bmin(std::numeric_limits<float>::max());
+            glm::vec3 bmax(-std::numeric_limits<float>::max());
+            for (uint32_t k = node.first; k < node.first + node.count; ++k)
+            {
+                bmin = glm::min(bmin, itemMin[order[k]]);
+                bmax = glm::max(bmax, itemMax[order[k]]);
+            }
+            node.bmin = bmin;
+            node.bmax = bmax;
+        }
+        else
+        {
+            const Node& l = nodes[node.first];
+            const Node& r = nodes[node.first + 1];
+            node.bmin = glm::min(l.bmin, r.bmin);
+            node.bmax = glm::max(l.bmax, r.bmax);
+        }
+    }
+}
+
+// slab test against a box grown by radius; returns the entry distance
+static bool rayHitsBox(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& bmin,
+    const glm::vec3& bmax, float radius, float maxT, float& outEntry)
+{
+    const glm::vec3 t0 = (bmin - glm::vec3(radius) - origin) * invDir;
+    const glm::vec3 t1 = (bmax + glm::vec3(radius) - origin) * invDir;
+    const glm::vec3 tNear = glm::min(t0, t1);
+    const glm::vec3 tFar = glm::max(t0, t1);
+
+    const float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+    outEntry = entry;
+    return entry <= exit;
+}
+
+template <typename Visit>
+void MeshBVH::Tree::traverse(const glm::vec3& origin, const glm::vec3& invDir, float radius, float& maxT, Visit&& visit) const
+{
+    if (nodes.empty())
+        return;
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+
+        float entry;
+        if (!rayHitsBox(origin, invDir, node.bmin, node.bmax, radius, maxT, entry))
+            continue;
+
+        if (node.count > 0)
+        {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k)
+                visit(order[k]);
+        }
+        else
+        {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+        }
+    }
+}
+
+// ---- mesh ---- //
+
+void MeshBVH::sync(const Mesh& mesh)
+{
+    if (builtTopologyVersion != mesh.getTopologyVersion()
+        || builtVertexCount != mesh.vertexCount()
+        || builtEdgeCount != mesh.edgeCount()
+        || builtFaceCount != mesh.faceCount())
+    {
+        rebuild(mesh);
+    }
+    else if (positionsDirty)
+    {
+        refit();
+    }
+}
+
+void MeshBVH::rebuild(const Mesh& mesh)
+{
+    triangles.clear();
+    for (Face* f : mesh.getFaces())
+    {
+        if (!f) continue;
+        const auto& verts = f->getVertices();
+        for (size_t i = 1; i + 1 < verts.size(); ++i)
+        {
+            if (!verts[0] || !verts[i] || !verts[i + 1]) continue;
+            triangles.push_back({ verts[0], verts[i], verts[i + 1], f });
+        }
+    }
+
+    edges.clear();
+    for (Edge* e : mesh.getEdges())
+        if (e && e->getStart() && e->getEnd())
+            edges.push_back(e);
+
+    vertices.clear();
+    for (Vertice* v : mesh.getVertices())
+        if (v) vertices.push_back(v);
+
+    computeItemBounds();
+    triangleTree.build(triMin, triMax);
+    edgeTree.build(edgeMin, edgeMax);
+    vertexTree.build(vertPos, vertPos);
+
+    builtTopologyVersion = mesh.getTopologyVersion();
+    builtVertexCount = mesh.vertexCount();
+    builtEdgeCount = mesh.edgeCount();
+    builtFaceCount = mesh.faceCount();
+    positionsDirty = false;
+}
+
+void MeshBVH::refit()
+{
+    computeItemBounds();
+    triangleTree.refit(triMin, triMax);
+    edgeTree.refit(edgeMin, edgeMax);
+    vertexTree.refit(vertPos, vertPos);
+    positionsDirty = false;
+}
+
+void MeshBVH::computeItemBounds()
+{
+    triMin.resize(triangles.size());
+    triMax.resize(triangles.size());
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        const glm::vec3 a = triangles[i].a->getLocalPosition();
+        const glm::vec3 b = triangles[i].b->getLocalPosition();
+        const glm::vec3 c = triangles[i].c->getLocalPosition();
+        triMin[i] = glm::min(a, glm::min(b, c));
+        triMax[i] = glm::max(a, glm::max(b, c));
+    }
+
+    edgeMin.resize(edges.size());
+    edgeMax.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        const glm::vec3 a = edges[i]->getStart()->getLocalPosition();
+        const glm::vec3 b = edges[i]->getEnd()->getLocalPosition();
+        edgeMin[i] = glm::min(a, b);
+        edgeMax[i] = glm::max(a, b);
+    }
+
+    vertPos.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+        vertPos[i] = vertices[i]->getLocalPosition();
+}
+
+// ---- queries ---- //
+
+bool MeshBVH::raycastFaces(const Mesh& mesh, const glm::vec3& origin, const glm::vec3& dir, float& outT, Face*& outFace)
+{
+    sync(mesh);
+
+    const glm::vec3 invDir = 1.0f / dir;
+    float bestT = std::numeric_limits<float>::max();
+    Face* bestFace = nullptr;
+
+    triangleTree.traverse(origin, invDir, 0.0f, bestT, [&](uint32_t item)
+    {
+        // Moller-Trumbore, two-sided
+        const TriangleRef& tri = triangles[item];
+        const glm::vec3 p0 = tri.a->getLocalPosition();
+        const glm::vec3 e1 = tri.b->getLocalPosition() - p0;
+        const glm::vec3 e2 = tri.c->getLocalPosition() - p0;
+
+        const glm::vec3 p = glm::cross(dir, e2);
+        const float det = glm::dot(e1, p);
+        if (std::abs(det) < 1e-12f) return;
+
+        const float invDet = 1.0f / det;
+        const glm::vec3 s = origin - p0;
+        const float u = glm::dot(s, p) * invDet;
+        if (u < 0.0f || u > 1.0f) return;
+
+        const glm::vec3 q = glm::cross(s, e1);
+        const float v = glm::dot(dir, q) * invDet;
+        if (v < 0.0f || u + v > 1.0f) return;
+
+        const float t = glm::dot(e2, q) * invDet;
+        if (t >= 0.0f && t < bestT)
+        {
+            bestT = t;
+            bestFace = tri.face;
+        }
+    });
+
+    if (!bestFace)
+        return false;
+
+    outT = bestT;
+    outFace = bestFace;
+    return true;
+}
+
+void MeshBVH::queryEdges(const Mesh& mesh, const glm::vec3& origin, const glm::vec3& dir, float radius, std::vector<Edge*>& out)
+{
+    sync(mesh);
+
+    const glm::vec3 invDir = 1.0f / dir;
+    float maxT = std::numeric_limits<float>::max();
+    edgeTree.traverse(origin, invDir, radius, maxT, [&](uint32_t item)
+    {
+        float entry;
+        if (rayHitsBox(origin, invDir, edgeMin[item], edgeMax[item], radius, maxT, entry))
+            out.push_back(edges[item]);
+    });
+}
+
+void MeshBVH::queryVertices(const Mesh& mesh, const glm::vec3& origin, const glm::vec3& dir, float radius, std::vector<Vertice*>& out)
+{
+    sync(mesh);
+
+    const glm::vec3 invDir = 1.0f / dir;
+    float maxT = std::numeric_limits<float>::max();
+    vertexTree.traverse(origin, invDir, radius, maxT, [&](uint32_t item)
+    {
+        float entry;
+        if (rayHitsBox(origin, invDir, vertPos[item], vertPos[item], radius, maxT, entry))
+            out.push_back(vertices[item]);
+    });
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+class Mesh;
+class Vertice;
+class Edge;
+class Face;
+
+// Bounding volume hierarchies over a mesh's triangles (fan-triangulated
+// faces), edges and vertices, all in mesh local space. Rebuilt when the
+// topology version changes, refit in place when only positions moved.
+//
+// Rays are given in local space with an unnormalized direction, so a hit
+// parameter t is the same along the local and the world ray.
+class MeshBVH
+{
+public:
+    void markPositionsDirty() { positionsDirty = true; }
+
+    // closest triangle hit along the ray
+    bool raycastFaces(const Mesh& mesh, const glm::vec3& origin, const glm::vec3& dir, float& outT, Face*& outFace);
+
+    // elements whose bounds, grown by radius, are crossed by the ray
+    void queryEdges(const Mesh& mesh, const glm::vec3& origin, const glm::vec3& dir, float radius, std::vector<Edge*>& out);
+    void queryVertices(const Mesh& mesh, const glm::vec3& origin, const glm::vec3& dir, float radius, std::vector<Vertice*>& out);
+
+    size_t getTriangleCount() const { return triangles.size(); }
+
+private:
+    struct Node
+    {
+        glm::vec3 bmin;
+        glm::vec3 bmax;
+        uint32_t first = 0;  // leaf : first item in order, inner : left child
+        uint32_t count = 0;  // 0 for inner nodes, right child is first + 1
+    };
+
+    struct Tree
+    {
+        std::vector<Node> nodes;
+        std::vector<uint32_t> order;
+
+        void build(const std::vector<glm::vec3>& itemMin, const std::vector<glm::vec3>& itemMax);
+        void refit(const std::vector<glm::vec3>& itemMin, const std::vector<glm::vec3>& itemMax);
+
+        template <typename Visit>
+        void traverse(const glm::vec3& origin, const glm::vec3& invDir, float radius, float& maxT, Visit&& visit) const;
+
+    private:
+        void buildNode(uint32_t index, uint32_t begin, uint32_t end, const std::vector<glm::vec3>& itemMin,
+            const std::vector<glm::vec3>& itemMax, const std::vector<glm::vec3>& centroids);
+    };
+
+    struct TriangleRef
+    {
+        const Vertice* a;
+        const Vertice* b;
+        const Vertice* c;
+        Face* face;
+    };
+
+    void sync(const Mesh& mesh);
+    void rebuild(const Mesh& mesh);
+    void refit();
+    void computeItemBounds();
+
+    uint64_t builtTopologyVersion = UINT64_MAX;
+    size_t builtVertexCount = 0;
+    size_t builtEdgeCount = 0;
+    size_t builtFaceCount = 0;
+    bool positionsDirty = true;
+
+    std::vector<TriangleRef> triangles;
+    std::vector<Edge*> edges;
+    std::vector<Vertice*> vertices;
+
+    Tree triangleTree;
+    Tree edgeTree;
+    Tree vertexTree;
+
+    // per-item bounds scratch, reused between refits
+    std::vector<glm::vec3> triMin, triMax;
+    std::vector<glm::vec3> edgeMin, edgeMax;
+    std::vector<glm::vec3> vertPos;
+};
@@ -0,0 +1,219 @@
+#include "WorldObjects/Mesh/MeshLoops.hpp"
+#include "WorldObjects/Mesh/MeshTopology.hpp"
+#include "WorldObjects/Basic/Vertice.hpp"
+#include <algorithm>
+
+static constexpr uint32_t kInvalid = MeshTopology::kInvalid;
+
+void MeshLoops::sync(const MeshTopology& topo)
+{
+    if (builtTopologyBuild == topo.getBuildCount())
+        return;
+
+    rings.clear();
+    loops.clear();
+    builtTopologyBuild = topo.getBuildCount();
+}
+
+void MeshLoops::beginWalk(const MeshTopology& topo)
+{
+    faceStamp.resize(topo.faceCount(), 0);
+    sideAStamp.resize(topo.edgeCount(), 0);
+    sideBStamp.resize(topo.edgeCount(), 0);
+
+    // on wrap-around old stamps could collide with the new walk
+    if (++walk == 0)
+    {
+        std::fill(faceStamp.begin(), faceStamp.end(), 0);
+        std::fill(sideAStamp.begin(), sideAStamp.end(), 0);
+        std::fill(sideBStamp.begin(), sideBStamp.end(), 0);
+        walk = 1;
+    }
+}
+
+// ---- edge ring ---- //
+
+const MeshLoops::Ring& MeshLoops::ring(const MeshTopology& topo, uint32_t seed)
+{
+    sync(topo);
+    auto found = rings.find(seed);
+    if (found != rings.end())
+        return found->second;
+
+    Ring& result = rings[seed];
+    beginWalk(topo);
+
+    auto markQuad = [&](uint32_t f)
+    {
+        faceStamp[f] = walk;
+        result.quads.push_back(topo.quad(f));
+    };
+
+    // crosses the first quad on e not crossed yet, returns the edge on its far side
+    auto stepAcross = [&](uint32_t e) -> uint32_t
+    {
+        const uint32_t first = topo.edgeHalfEdge(e);
+        if (first == kInvalid) return kInvalid;
+
+        uint32_t he = first;
+        do
+        {
+            const uint32_t f = topo.faceOf(he);
+            if (topo.quad(f) && faceStamp[f] != walk)
+            {
+                markQuad(f);
+                return topo.oppositeEdgeInQuad(e, f);
+            }
+            he = topo.radial(he);
+        } while (he != first);
+
+        return kInvalid;
+    };
+
+    // every quad around the seed opens one side of the ring
+    uint32_t exits[2] = { kInvalid, kInvalid };
+    const uint32_t seedFirst = topo.edgeHalfEdge(seed);
+    if (seedFirst != kInvalid)
+    {
+        uint32_t he = seedFirst;
+        int exitCount = 0;
+        do
+        {
+            const uint32_t f = topo.faceOf(he);
+            if (topo.quad(f) && faceStamp[f] != walk)
+            {
+                markQuad(f);
+                const uint32_t opposite = topo.oppositeEdgeInQuad(seed, f);
+                if (opposite != kInvalid && exitCount < 2) exits[exitCount++] = opposite;
+            }
+            he = topo.radial(he);
+        } while (he != seedFirst);
+    }
+
+    std::vector<uint32_t> sideA{ seed };
+    std::vector<uint32_t> sideB{ seed };
+    sideAStamp[seed] = walk;
+    sideBStamp[seed] = walk;
+
+    // both sides advance one quad at a time and stop where they meet
+    uint32_t currentA = exits[0];
+    uint32_t currentB = exits[1];
+    while (currentA != kInvalid || currentB != kInvalid)
+    {
+        if (currentA != kInvalid)
+        {
+            sideA.push_back(currentA);
+            sideAStamp[currentA] = walk;
+
+            const uint32_t nextA = stepAcross(currentA);
+            if (nextA != kInvalid && currentB != kInvalid && sideBStamp[nextA] == walk)
+                break;
+            currentA = nextA;
+        }
+
+        if (currentB != kInvalid)
+        {
+            sideB.push_back(currentB);
+            sideBStamp[currentB] = walk;
+
+            const uint32_t nextB = stepAcross(currentB);
+            if (nextB != kInvalid && sideAStamp[nextB] == walk)
+                break;
+            currentB = nextB;
+        }
+    }
+
+    // ---- quad bridging the two ends ---- //
+    const uint32_t joinFace = topo.sharedFace(sideA.back(), sideB.back());
+    if (joinFace != kInvalid && topo.quad(joinFace))
+    {
+        result.joinQuad = topo.quad(joinFace);
+        if (faceStamp[joinFace] != walk)
+            markQuad(joinFace);
+    }
+
+    result.sideA.reserve(sideA.size());
+    result.sideB.reserve(sideB.size());
+    result.edges.reserve(sideA.size() + sideB.size());
+    for (uint32_t e : sideA)
+    {
+        result.sideA.push_back(topo.edge(e));
+        result.edges.push_back(topo.edge(e));
+    }
+    for (uint32_t e : sideB)
+        result.sideB.push_back(topo.edge(e));
+    for (auto it = sideB.rbegin(); it != sideB.rend(); ++it)
+    {
+        if (sideAStamp[*it] != walk)
+            result.edges.push_back(topo.edge(*it));
+    }
+
+    return result;
+}
+
+// ---- edge loop ---- //
+
+const MeshLoops::Loop& MeshLoops::loop(const MeshTopology& topo, uint32_t seed)
+{
+    sync(topo);
+    auto found = loops.find(seed);
+    if (found != loops.end())
+        return found->second;
+
+    Loop& result = loops[seed];
+    beginWalk(topo);
+    sideAStamp[seed] = walk;
+
+    // a loop only runs straight through vertices surrounded by four faces
+    auto passable = [&](uint32_t v)
+    {
+        return topo.vertice(v)->getFaces().size() == 4;
+    };
+
+    const uint32_t start = topo.edgeHalfEdge(seed);
+    std::vector<uint32_t> forward;
+    std::vector<uint32_t> backward;
+
+    if (start != kInvalid)
+    {
+        // forward : leave the face through the next side, come back in through its twin
+        uint32_t he = start;
+        while (passable(topo.target(he)))
+        {
+            const uint32_t across = topo.twin(topo.next(he));
+            if (across == kInvalid) break;
+
+            he = topo.next(across);
+            const uint32_t e = topo.edgeOf(he);
+            if (e == seed) { result.closed = true; break; }
+            if (e == kInvalid || sideAStamp[e] == walk) break;
+
+            sideAStamp[e] = walk;
+            forward.push_back(e);
+        }
+
+        // backward : same walk mirrored through prev, only needed for open loops
+        he = start;
+        while (!result.closed && passable(topo.origin(he)))
+        {
+            const uint32_t across = topo.twin(topo.prev(he));
+            if (across == kInvalid) break;
+
+            he = topo.prev(across);
+            const uint32_t e = topo.edgeOf(he);
+            if (e == kInvalid || sideAStamp[e] == walk) break;
+
+            sideAStamp[e] = walk;
+            backward.push_back(e);
+        }
+    }
+
+    result.edges.reserve(backward.size() + 1 + forward.size());
+    for (auto it = backward.rbegin(); it != backward.rend(); ++it)
+        result.edges.push_back(topo.edge(*it));
+    result.edges.push_back(topo.edge(seed));
+    for (uint32_t e : forward)
+        result.edges.push_back(topo.edge(e));
+
+    return result;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+class MeshTopology;
+class Edge;
+class Quad;
+
+// Edge rings (edges met by crossing quads to their opposite side) and edge
+// loops (edges running straight through vertices with four faces) walked over a
+// MeshTopology. Walks stamp what they visit, so their cost is linear in the
+// length of the result whatever its size, and results are memoized per seed
+// edge until the topology is rebuilt.
+class MeshLoops
+{
+public:
+    struct Ring
+    {
+        // both sides start at the seed and run outwards until they meet,
+        // reach the border or hit a face that is not a quad
+        std::vector<Edge*> sideA;
+        std::vector<Edge*> sideB;
+        std::vector<Edge*> edges;  // seed, side A outwards, side B back in
+        std::vector<Quad*> quads;  // every quad crossed, once
+        Quad* joinQuad = nullptr;  // quad holding the last edge of both sides
+    };
+
+    struct Loop
+    {
+        std::vector<Edge*> edges;  // in walk order, the seed somewhere inside
+        bool closed = false;
+    };
+
+    const Ring& ring(const MeshTopology& topo, uint32_t seed);
+    const Loop& loop(const MeshTopology& topo, uint32_t seed);
+
+    size_t cachedCount() const { return rings.size() + loops.size(); }
+
+private:
+    void sync(const MeshTopology& topo);
+    void beginWalk(const MeshTopology& topo);
+
+    uint64_t builtTopologyBuild = UINT64_MAX;
+    std::unordered_map<uint32_t, Ring> rings;
+    std::unordered_map<uint32_t, Loop> loops;
+
+    // a handle is marked when its stamp equals the current walk
+    uint32_t walk = 0;
+    std::vector<uint32_t> faceStamp;
+    std::vector<uint32_t> sideAStamp;
+    std::vector<uint32_t> sideBStamp;
+};
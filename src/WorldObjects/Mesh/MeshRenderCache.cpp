@@ -0,0 +1,513 @@
+#include "WorldObjects/Mesh/MeshRenderCache.hpp"
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include "WorldObjects/Basic/Vertice.hpp"
+#include "WorldObjects/Basic/Edge.hpp"
+#include "WorldObjects/Basic/Face.hpp"
+#include "Engine/ShaderLibrary.hpp"
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
+#include <unordered_map>
+#include <algorithm>
+
+MeshRenderCache::~MeshRenderCache()
+{
+    destroy();
+}
+
+void MeshRenderCache::createGLObjects()
+{
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &positionVbo);
+    glGenBuffers(1, &triangleEbo);
+    glGenBuffers(1, &lineEbo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, positionVbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    for (ElementState* state : { &vertexState, &edgeState, &triangleState })
+    {
+        for (StateBuffer* buffer : { &state->flags, &state->colors })
+        {
+            glGenBuffers(1, &buffer->buffer);
+            glGenTextures(1, &buffer->texture);
+            glBindBuffer(GL_TEXTURE_BUFFER, buffer->buffer);
+            glBindTexture(GL_TEXTURE_BUFFER, buffer->texture);
+            glTexBuffer(GL_TEXTURE_BUFFER, buffer == &state->flags ? GL_R8UI : GL_RGBA8, buffer->buffer);
+        }
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glReady = true;
+    topologyDirty = true;
+}
+
+void MeshRenderCache::destroy()
+{
+    if (!glReady) return;
+
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &positionVbo);
+    glDeleteBuffers(1, &triangleEbo);
+    glDeleteBuffers(1, &lineEbo);
+    vao = positionVbo = triangleEbo = lineEbo = 0;
+
+    for (ElementState* state : { &vertexState, &edgeState, &triangleState })
+    {
+        for (StateBuffer* buffer : { &state->flags, &state->colors })
+        {
+            glDeleteTextures(1, &buffer->texture);
+            glDeleteBuffers(1, &buffer->buffer);
+        }
+        *state = ElementState{};
+    }
+
+    glReady = false;
+    topologyDirty = true;
+}
+
+bool MeshRenderCache::needsRebuild(const Mesh& mesh) const
+{
+    // the size check catches callers that still push into the mesh vectors directly
+    return topologyDirty
+        || builtTopologyVersion != mesh.getTopologyVersion()
+        || builtVertexCount != mesh.vertexCount()
+        || builtEdgeCount != mesh.edgeCount()
+        || builtFaceCount != mesh.faceCount();
+}
+
+void MeshRenderCache::rebuildTopology(const Mesh& mesh)
+{
+    const auto& meshVertices = mesh.getVertices();
+    const auto& meshEdges = mesh.getEdges();
+    const auto& meshFaces = mesh.getFaces();
+
+    pointVertices.clear();
+    lineEdges.clear();
+    triangleFaces.clear();
+
+    std::unordered_map<const Vertice*, uint32_t> indexOf;
+    indexOf.reserve(meshVertices.size());
+    pointVertices.reserve(meshVertices.size());
+    for (Vertice* v : meshVertices)
+    {
+        if (!v) continue;
+        const uint32_t slot = static_cast<uint32_t>(pointVertices.size());
+        indexOf.emplace(v, slot);
+        v->setRenderSlot(slot);
+        pointVertices.push_back(v);
+    }
+
+    std::vector<uint32_t> lineIndices;
+    lineIndices.reserve(meshEdges.size() * 2);
+    lineEdges.reserve(meshEdges.size());
+    for (Edge* e : meshEdges)
+    {
+        if (!e) continue;
+        auto a = indexOf.find(e->getStart());
+        auto b = indexOf.find(e->getEnd());
+        if (a == indexOf.end() || b == indexOf.end()) continue;
+        lineIndices.push_back(a->second);
+        lineIndices.push_back(b->second);
+        lineEdges.push_back(e);
+    }
+
+    // faces are fan-triangulated, one state entry per emitted triangle
+    std::vector<uint32_t> triangleIndices;
+    triangleIndices.reserve(meshFaces.size() * 6);
+    triangleFaces.reserve(meshFaces.size() * 2);
+    std::vector<uint32_t> ring;
+    for (Face* f : meshFaces)
+    {
+        if (!f) continue;
+
+        ring.clear();
+        for (const Vertice* v : f->getVertices())
+        {
+            auto it = v ? indexOf.find(v) : indexOf.end();
+            if (it != indexOf.end()) ring.push_back(it->second);
+        }
+        if (ring.size() < 3) continue;
+
+        for (size_t k = 1; k + 1 < ring.size(); ++k)
+        {
+            triangleIndices.push_back(ring[0]);
+            triangleIndices.push_back(ring[k]);
+            triangleIndices.push_back(ring[k + 1]);
+            triangleFaces.push_back(f);
+        }
+    }
+
+    positions.resize(pointVertices.size());
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, positionVbo);
+    glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), nullptr, GL_DYNAMIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangleEbo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, triangleIndices.size() * sizeof(uint32_t), triangleIndices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lineEbo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, lineIndices.size() * sizeof(uint32_t), lineIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    builtTopologyVersion = mesh.getTopologyVersion();
+    builtVertexCount = mesh.vertexCount();
+    builtEdgeCount = mesh.edgeCount();
+    builtFaceCount = mesh.faceCount();
+    topologyDirty = false;
+    allPositionsDirty = true;
+    dirtySlots.clear();
+
+    // draw order changed, so every state buffer is rebuilt and hover is dropped
+    for (ElementState* state : { &vertexState, &edgeState, &triangleState })
+    {
+        state->flagsStale = true;
+        state->colorsStale = true;
+        state->hoverFirst = 0;
+        state->hoverCount = 0;
+    }
+}
+
+void MeshRenderCache::markPositionDirty(uint32_t slot)
+{
+    if (allPositionsDirty || slot >= pointVertices.size())
+        return;
+
+    // past this point a full upload is cheaper than tracking spans
+    if (dirtySlots.size() >= pointVertices.size() / 2)
+    {
+        allPositionsDirty = true;
+        dirtySlots.clear();
+        return;
+    }
+    dirtySlots.push_back(slot);
+}
+
+void MeshRenderCache::uploadAllPositions()
+{
+    for (size_t i = 0; i < pointVertices.size(); ++i)
+        positions[i] = pointVertices[i]->getLocalPosition();
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionVbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, positions.size() * sizeof(glm::vec3), positions.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    allPositionsDirty = false;
+    dirtySlots.clear();
+}
+
+void MeshRenderCache::uploadDirtyPositions()
+{
+    if (dirtySlots.empty())
+        return;
+
+    std::sort(dirtySlots.begin(), dirtySlots.end());
+    dirtySlots.erase(std::unique(dirtySlots.begin(), dirtySlots.end()), dirtySlots.end());
+
+    // slots closer than this are merged into one span to save driver calls
+    constexpr uint32_t kMaxGap = 8;
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionVbo);
+    size_t i = 0;
+    while (i < dirtySlots.size())
+    {
+        const uint32_t first = dirtySlots[i];
+        uint32_t last = first;
+        while (i + 1 < dirtySlots.size() && dirtySlots[i + 1] - last <= kMaxGap)
+            last = dirtySlots[++i];
+        ++i;
+
+        for (uint32_t slot = first; slot <= last; ++slot)
+            positions[slot] = pointVertices[slot]->getLocalPosition();
+
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(glm::vec3),
+            (last - first + 1) * sizeof(glm::vec3), &positions[first]);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    dirtySlots.clear();
+}
+
+MeshRenderCache::ElementState& MeshRenderCache::stateFor(PickTarget kind)
+{
+    switch (kind)
+    {
+    case PickTarget::Vertice: return vertexState;
+    case PickTarget::Edge:    return edgeState;
+    default:                  return triangleState;
+    }
+}
+
+void MeshRenderCache::markStateDirty(PickTarget kind, bool colorsChanged)
+{
+    ElementState& state = stateFor(kind);
+    state.flagsStale = true;
+    if (colorsChanged)
+        state.colorsStale = true;
+}
+
+void MeshRenderCache::setHoverBits(ElementState& state, bool on)
+{
+    if (state.hoverCount == 0)
+        return;
+
+    const uint32_t last = state.hoverFirst + state.hoverCount - 1;
+    if (last >= state.flagData.size())
+        return;
+
+    for (uint32_t i = state.hoverFirst; i <= last; ++i)
+    {
+        if (on) state.flagData[i] |= kFlagHovered;
+        else    state.flagData[i] &= static_cast<uint8_t>(~kFlagHovered);
+    }
+    state.patchFirst = std::min(state.patchFirst, state.hoverFirst);
+    state.patchLast = std::max(state.patchLast, last);
+}
+
+bool MeshRenderCache::setHovered(PickTarget kind, uint32_t index)
+{
+    ElementState& state = stateFor(kind);
+
+    size_t count = 0;
+    switch (kind)
+    {
+    case PickTarget::Vertice: count = pointVertices.size(); break;
+    case PickTarget::Edge:    count = lineEdges.size(); break;
+    case PickTarget::Face:    count = triangleFaces.size(); break;
+    }
+
+    uint32_t first = 0;
+    uint32_t hoverCount = 0;
+    if (index < count)
+    {
+        first = index;
+        uint32_t last = index;
+        if (kind == PickTarget::Face)
+        {
+            // triangles of one face are emitted contiguously
+            const Face* face = triangleFaces[index];
+            while (first > 0 && triangleFaces[first - 1] == face) --first;
+            while (last + 1 < count && triangleFaces[last + 1] == face) ++last;
+        }
+        hoverCount = last - first + 1;
+    }
+
+    if (first == state.hoverFirst && hoverCount == state.hoverCount)
+        return false;
+
+    setHoverBits(state, false);
+    state.hoverFirst = first;
+    state.hoverCount = hoverCount;
+    setHoverBits(state, true);
+    return true;
+}
+
+void MeshRenderCache::gatherStates(PickTarget kind)
+{
+    ElementState& state = stateFor(kind);
+
+    auto gather = [&](const auto& elements)
+    {
+        const size_t count = elements.size();
+        if (state.flagsStale)
+        {
+            state.flagData.resize(count);
+            for (size_t i = 0; i < count; ++i)
+                state.flagData[i] = elements[i]->isSelected() ? kFlagSelected : 0;
+        }
+        if (state.colorsStale)
+        {
+            state.colorData.resize(count);
+            for (size_t i = 0; i < count; ++i)
+                state.colorData[i] = glm::packUnorm4x8(elements[i]->getColor());
+        }
+    };
+
+    switch (kind)
+    {
+    case PickTarget::Vertice: gather(pointVertices); break;
+    case PickTarget::Edge:    gather(lineEdges); break;
+    case PickTarget::Face:    gather(triangleFaces); break;
+    }
+
+    if (state.flagsStale)
+        setHoverBits(state, true);
+}
+
+void MeshRenderCache::uploadStates()
+{
+    for (PickTarget kind : { PickTarget::Vertice, PickTarget::Edge, PickTarget::Face })
+    {
+        ElementState& state = stateFor(kind);
+        if (!state.flagsStale && !state.colorsStale && state.patchFirst == UINT32_MAX)
+            continue;
+
+        gatherStates(kind);
+
+        if (state.flagsStale)
+        {
+            glBindBuffer(GL_TEXTURE_BUFFER, state.flags.buffer);
+            glBufferData(GL_TEXTURE_BUFFER, state.flagData.size(), state.flagData.data(), GL_DYNAMIC_DRAW);
+        }
+        else if (state.patchFirst != UINT32_MAX && state.patchLast < state.flagData.size())
+        {
+            glBindBuffer(GL_TEXTURE_BUFFER, state.flags.buffer);
+            glBufferSubData(GL_TEXTURE_BUFFER, state.patchFirst, state.patchLast - state.patchFirst + 1,
+                &state.flagData[state.patchFirst]);
+        }
+
+        if (state.colorsStale)
+        {
+            glBindBuffer(GL_TEXTURE_BUFFER, state.colors.buffer);
+            glBufferData(GL_TEXTURE_BUFFER, state.colorData.size() * sizeof(uint32_t), state.colorData.data(), GL_DYNAMIC_DRAW);
+        }
+
+        state.flagsStale = false;
+        state.colorsStale = false;
+        state.patchFirst = UINT32_MAX;
+        state.patchLast = 0;
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+bool MeshRenderCache::prepare(const Mesh& mesh)
+{
+    if (!glReady)
+        createGLObjects();
+
+    if (needsRebuild(mesh))
+        rebuildTopology(mesh);
+
+    if (pointVertices.empty())
+        return false;
+
+    if (allPositionsDirty)
+        uploadAllPositions();
+    else
+        uploadDirtyPositions();
+    return true;
+}
+
+void MeshRenderCache::render(const Mesh& mesh, const glm::mat4& modelMatrix)
+{
+    if (!prepare(mesh))
+        return;
+
+    uploadStates();
+
+    ShaderLibrary& shaders = ShaderLibrary::get();
+
+    // colors on unit 0, flags on unit 1 (see ShaderLibrary sampler bindings)
+    auto bindState = [](const ElementState& state)
+    {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_BUFFER, state.flags.texture);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_BUFFER, state.colors.texture);
+    };
+
+    glBindVertexArray(vao);
+
+    // ---- faces ---- //
+    if (!triangleFaces.empty())
+    {
+        const ShaderProgram& faceProgram = shaders.program(ShaderKind::FaceStripe);
+        glUseProgram(faceProgram.getID());
+        glUniformMatrix4fv(faceProgram.location(ShaderUniform::Model), 1, GL_FALSE, glm::value_ptr(modelMatrix));
+        bindState(triangleState);
+
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(1.0f, 1.0f);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangleEbo);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(triangleFaces.size() * 3), GL_UNSIGNED_INT, (void*)0);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+    }
+
+    // ---- vertices ---- //
+    const ShaderProgram& pointProgram = shaders.program(ShaderKind::Point);
+    glUseProgram(pointProgram.getID());
+    glUniformMatrix4fv(pointProgram.location(ShaderUniform::Model), 1, GL_FALSE, glm::value_ptr(modelMatrix));
+    bindState(vertexState);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(pointVertices.size()));
+
+    // ---- edges ---- //
+    if (!lineEdges.empty())
+    {
+        const ShaderProgram& lineProgram = shaders.program(ShaderKind::Line);
+        glUseProgram(lineProgram.getID());
+        glUniformMatrix4fv(lineProgram.location(ShaderUniform::Model), 1, GL_FALSE, glm::value_ptr(modelMatrix));
+        bindState(edgeState);
+
+        glLineWidth(2.0f);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lineEbo);
+        glDrawElements(GL_LINES, static_cast<GLsizei>(lineEdges.size() * 2), GL_UNSIGNED_INT, (void*)0);
+        glLineWidth(1.0f);
+    }
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void MeshRenderCache::renderPick(const Mesh& mesh, const glm::mat4& modelMatrix, PickTarget target, uint32_t objectId)
+{
+    if (!prepare(mesh))
+        return;
+
+    ShaderLibrary& shaders = ShaderLibrary::get();
+    const ShaderProgram& primitiveProgram = shaders.program(ShaderKind::PickPrimitive);
+
+    glBindVertexArray(vao);
+
+    // ---- faces : ids in face mode, depth only otherwise ---- //
+    if (!triangleFaces.empty())
+    {
+        glUseProgram(primitiveProgram.getID());
+        glUniformMatrix4fv(primitiveProgram.location(ShaderUniform::Model), 1, GL_FALSE, glm::value_ptr(modelMatrix));
+        glUniform1ui(primitiveProgram.location(ShaderUniform::PickObject), objectId);
+
+        if (target != PickTarget::Face)
+            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(1.0f, 1.0f);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangleEbo);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(triangleFaces.size() * 3), GL_UNSIGNED_INT, (void*)0);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    }
+
+    if (target == PickTarget::Vertice)
+    {
+        const ShaderProgram& pointProgram = shaders.program(ShaderKind::PickPoint);
+        glUseProgram(pointProgram.getID());
+        glUniformMatrix4fv(pointProgram.location(ShaderUniform::Model), 1, GL_FALSE, glm::value_ptr(modelMatrix));
+        glUniform1ui(pointProgram.location(ShaderUniform::PickObject), objectId);
+        glEnable(GL_PROGRAM_POINT_SIZE);
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(pointVertices.size()));
+    }
+    else if (target == PickTarget::Edge && !lineEdges.empty())
+    {
+        glUseProgram(primitiveProgram.getID());
+        glUniformMatrix4fv(primitiveProgram.location(ShaderUniform::Model), 1, GL_FALSE, glm::value_ptr(modelMatrix));
+        glUniform1ui(primitiveProgram.location(ShaderUniform::PickObject), objectId);
+
+        glLineWidth(2.0f);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lineEbo);
+        glDrawElements(GL_LINES, static_cast<GLsizei>(lineEdges.size() * 2), GL_UNSIGNED_INT, (void*)0);
+        glLineWidth(1.0f);
+    }
+
+    glBindVertexArray(0);
+}
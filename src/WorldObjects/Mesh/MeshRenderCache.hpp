@@ -0,0 +1,125 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Mesh;
+class Vertice;
+class Edge;
+class Face;
+
+enum class PickTarget
+{
+    Vertice,
+    Edge,
+    Face
+};
+
+// Packs a whole mesh into one position buffer plus index buffers, so that
+// faces, edges and vertex handles are drawn with a single call each.
+// Per-element state lives in texture buffers indexed by gl_PrimitiveID
+// (faces, edges) or gl_VertexID (vertices) : one R8UI flag byte (selected,
+// hovered) and one RGBA8 color, each re-uploaded only when it changed.
+class MeshRenderCache
+{
+public:
+    MeshRenderCache() = default;
+    ~MeshRenderCache();
+
+    MeshRenderCache(const MeshRenderCache&) = delete;
+    MeshRenderCache& operator=(const MeshRenderCache&) = delete;
+
+    // view / projection come from the CameraBlock uniform buffer
+    void render(const Mesh& mesh, const glm::mat4& modelMatrix);
+
+    // id pass for GPU picking; faces are always written to depth so hidden
+    // vertices / edges cannot be picked through the surface
+    void renderPick(const Mesh& mesh, const glm::mat4& modelMatrix, PickTarget target, uint32_t objectId);
+
+    // element index as read back from the pick buffer (already minus one)
+    Vertice* getPickedVertice(uint32_t index) const { return index < pointVertices.size() ? pointVertices[index] : nullptr; }
+    Edge* getPickedEdge(uint32_t index) const { return index < lineEdges.size() ? lineEdges[index] : nullptr; }
+    Face* getPickedFace(uint32_t index) const { return index < triangleFaces.size() ? triangleFaces[index] : nullptr; }
+    void invalidate() { topologyDirty = true; }
+
+    // slot is the vertex's position in the shared buffer (Vertice::getRenderSlot)
+    void markPositionDirty(uint32_t slot);
+
+    // selection / color of some element of this kind changed
+    void markStateDirty(PickTarget kind, bool colorsChanged);
+
+    // draw-order index as returned by the pick pass, UINT32_MAX clears;
+    // a face index expands to every triangle of that face; false when unchanged
+    bool setHovered(PickTarget kind, uint32_t index);
+    void destroy();
+
+    size_t getTriangleCount() const { return triangleFaces.size(); }
+    size_t getLineCount() const { return lineEdges.size(); }
+    size_t getPointCount() const { return pointVertices.size(); }
+
+private:
+    struct StateBuffer
+    {
+        unsigned int buffer = 0;
+        unsigned int texture = 0;
+    };
+
+    static constexpr uint8_t kFlagSelected = 1;
+    static constexpr uint8_t kFlagHovered = 2;
+
+    struct ElementState
+    {
+        StateBuffer flags;
+        StateBuffer colors;
+        std::vector<uint8_t> flagData;
+        std::vector<uint32_t> colorData;
+
+        bool flagsStale = true;
+        bool colorsStale = true;
+
+        uint32_t hoverFirst = 0;
+        uint32_t hoverCount = 0;
+
+        // flag bytes patched by hover since the last upload
+        uint32_t patchFirst = UINT32_MAX;
+        uint32_t patchLast = 0;
+    };
+
+    void createGLObjects();
+    bool prepare(const Mesh& mesh);
+
+    bool needsRebuild(const Mesh& mesh) const;
+    void rebuildTopology(const Mesh& mesh);
+    void uploadAllPositions();
+    void uploadDirtyPositions();
+    ElementState& stateFor(PickTarget kind);
+    void gatherStates(PickTarget kind);
+    void uploadStates();
+    static void setHoverBits(ElementState& state, bool on);
+
+    bool glReady = false;
+    bool topologyDirty = true;
+    uint64_t builtTopologyVersion = 0;
+    size_t builtVertexCount = 0;
+    size_t builtEdgeCount = 0;
+    size_t builtFaceCount = 0;
+
+    unsigned int vao = 0;
+    unsigned int positionVbo = 0;
+    unsigned int triangleEbo = 0;
+    unsigned int lineEbo = 0;
+
+    ElementState vertexState;
+    ElementState edgeState;
+    ElementState triangleState;
+
+    // ---- draw order -> element, rebuilt with the topology ---- //
+    std::vector<Vertice*> pointVertices;
+    std::vector<Edge*> lineEdges;
+    std::vector<Face*> triangleFaces;
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> dirtySlots;
+    bool allPositionsDirty = true;
+};
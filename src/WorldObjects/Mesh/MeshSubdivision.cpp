@@ -0,0 +1,297 @@
+#include "WorldObjects/Mesh/MeshSubdivision.hpp"
+#include "WorldObjects/Mesh/MeshTopology.hpp"
+#include <algorithm>
+#include <thread>
+
+static constexpr uint32_t kInvalid = MeshSubdivision::kInvalid;
+
+// splits [0, count) into one contiguous chunk per thread, the caller runs the last one;
+// small passes stay on the calling thread where spawning would cost more than it saves
+template <typename Fn>
+static void parallelFor(size_t count, unsigned threads, const Fn& fn)
+{
+    static constexpr size_t kMinChunk = 4096;
+    const size_t workers = std::min<size_t>(threads, (count + kMinChunk - 1) / kMinChunk);
+    if (workers <= 1)
+    {
+        fn(size_t(0), count);
+        return;
+    }
+
+    const size_t chunk = (count + workers - 1) / workers;
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t w = 0; w + 1 < workers; ++w)
+        pool.emplace_back([&fn, w, chunk, count] { fn(std::min(count, w * chunk), std::min(count, (w + 1) * chunk)); });
+    fn(std::min(count, (workers - 1) * chunk), count);
+
+    for (std::thread& t : pool)
+        t.join();
+}
+
+static unsigned resolveThreads(unsigned threads)
+{
+    if (threads > 0)
+        return threads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// ---- cage from the half-edge view ---- //
+
+MeshSubdivision::Cage MeshSubdivision::fromTopology(const MeshTopology& topo)
+{
+    Cage cage;
+    const uint32_t vertexCount = topo.vertexCount();
+    cage.points.resize(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+        cage.points[v] = topo.position(v);
+
+    // only edges some face runs along take part, numbered in topology order
+    std::vector<uint32_t> cageEdge(topo.edgeCount(), kInvalid);
+    for (uint32_t e = 0; e < topo.edgeCount(); ++e)
+    {
+        const uint32_t first = topo.edgeHalfEdge(e);
+        if (first == kInvalid) continue;
+
+        cageEdge[e] = static_cast<uint32_t>(cage.edgeCount());
+        cage.edgeVerts.push_back(topo.origin(first));
+        cage.edgeVerts.push_back(topo.target(first));
+
+        // past two faces the edge is treated as a border, like an open one
+        const uint32_t second = topo.radial(first);
+        const bool manifold = second != first && topo.radial(second) == first;
+        cage.edgeFaces.push_back(topo.faceOf(first));
+        cage.edgeFaces.push_back(manifold ? topo.faceOf(second) : kInvalid);
+    }
+
+    cage.faceStart.reserve(topo.faceCount() + 1);
+    cage.corners.reserve(topo.halfEdgeCount());
+    cage.cornerEdge.reserve(topo.halfEdgeCount());
+    for (uint32_t f = 0; f < topo.faceCount(); ++f)
+    {
+        cage.faceStart.push_back(static_cast<uint32_t>(cage.corners.size()));
+        uint32_t he = topo.faceHalfEdge(f);
+        for (uint32_t i = 0; i < topo.faceSize(f); ++i, he = topo.next(he))
+        {
+            // a side with no edge behind it gets a border edge of its own
+            uint32_t e = topo.edgeOf(he) != kInvalid ? cageEdge[topo.edgeOf(he)] : kInvalid;
+            if (e == kInvalid)
+            {
+                e = static_cast<uint32_t>(cage.edgeCount());
+                cage.edgeVerts.push_back(topo.origin(he));
+                cage.edgeVerts.push_back(topo.target(he));
+                cage.edgeFaces.push_back(f);
+                cage.edgeFaces.push_back(kInvalid);
+            }
+            cage.corners.push_back(topo.origin(he));
+            cage.cornerEdge.push_back(e);
+        }
+    }
+    cage.faceStart.push_back(static_cast<uint32_t>(cage.corners.size()));
+    return cage;
+}
+
+// ---- one Catmull-Clark step ---- //
+
+MeshSubdivision::Cage MeshSubdivision::refine(const Cage& cage, unsigned threads)
+{
+    threads = resolveThreads(threads);
+
+    const size_t V = cage.vertexCount();
+    const size_t E = cage.edgeCount();
+    const size_t F = cage.faceCount();
+    const size_t H = cage.corners.size();
+
+    // child vertices : vertex points, then edge points, then face points
+    const uint32_t edgeBase = static_cast<uint32_t>(V);
+    const uint32_t faceBase = static_cast<uint32_t>(V + E);
+
+    Cage child;
+    child.points.resize(V + E + F);
+    glm::vec3* facePoint = child.points.data() + faceBase;
+    glm::vec3* edgePoint = child.points.data() + edgeBase;
+
+    parallelFor(F, threads, [&](size_t begin, size_t end)
+    {
+        for (size_t f = begin; f < end; ++f)
+        {
+            glm::vec3 sum(0.0f);
+            for (uint32_t c = cage.faceStart[f]; c < cage.faceStart[f + 1]; ++c)
+                sum += cage.points[cage.corners[c]];
+            facePoint[f] = sum / static_cast<float>(cage.faceStart[f + 1] - cage.faceStart[f]);
+        }
+    });
+
+    parallelFor(E, threads, [&](size_t begin, size_t end)
+    {
+        for (size_t e = begin; e < end; ++e)
+        {
+            const glm::vec3 ends = cage.points[cage.edgeVerts[2 * e]] + cage.points[cage.edgeVerts[2 * e + 1]];
+            const uint32_t f1 = cage.edgeFaces[2 * e + 1];
+            edgePoint[e] = f1 == kInvalid ? ends * 0.5f
+                : (ends + facePoint[cage.edgeFaces[2 * e]] + facePoint[f1]) * 0.25f;
+        }
+    });
+
+    // ---- vertex points gather over each vertex's edges ---- //
+    std::vector<uint32_t> vertEdgeStart(V + 1, 0);
+    for (size_t i = 0; i < 2 * E; ++i)
+        ++vertEdgeStart[cage.edgeVerts[i] + 1];
+    for (size_t v = 0; v < V; ++v)
+        vertEdgeStart[v + 1] += vertEdgeStart[v];
+
+    std::vector<uint32_t> vertEdges(2 * E);
+    {
+        std::vector<uint32_t> cursor(vertEdgeStart.begin(), vertEdgeStart.end() - 1);
+        for (size_t i = 0; i < 2 * E; ++i)
+            vertEdges[cursor[cage.edgeVerts[i]]++] = static_cast<uint32_t>(i / 2);
+    }
+
+    parallelFor(V, threads, [&](size_t begin, size_t end)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            const glm::vec3 p = cage.points[v];
+            const uint32_t first = vertEdgeStart[v];
+            const uint32_t n = vertEdgeStart[v + 1] - first;
+
+            glm::vec3 faceSum(0.0f);
+            glm::vec3 midSum(0.0f);
+            glm::vec3 borderSum(0.0f);
+            uint32_t borders = 0;
+            for (uint32_t i = first; i < first + n; ++i)
+            {
+                const uint32_t e = vertEdges[i];
+                const uint32_t other = cage.edgeVerts[2 * e] == v ? cage.edgeVerts[2 * e + 1] : cage.edgeVerts[2 * e];
+                const glm::vec3 q = cage.points[other];
+                midSum += (p + q) * 0.5f;
+
+                const uint32_t f1 = cage.edgeFaces[2 * e + 1];
+                if (f1 == kInvalid)
+                {
+                    borderSum += q;
+                    ++borders;
+                }
+                else
+                {
+                    faceSum += facePoint[cage.edgeFaces[2 * e]] + facePoint[f1];
+                }
+            }
+
+            // corners and non-manifold fans stay where they are
+            glm::vec3 result = p;
+            if (borders == 0 && n >= 3)
+            {
+                // each face around v borders two of its edges, so it was summed twice
+                const float fn = static_cast<float>(n);
+                const glm::vec3 F = faceSum / (2.0f * fn);
+                const glm::vec3 R = midSum / fn;
+                result = (F + 2.0f * R + (fn - 3.0f) * p) / fn;
+            }
+            else if (borders == 2)
+            {
+                result = (6.0f * p + borderSum) * 0.125f;
+            }
+            child.points[v] = result;
+        }
+    });
+
+    // ---- refined connectivity ---- //
+    // parent edge e splits into 2e (start side) and 2e + 1 (end side),
+    // corner c adds edge 2E + c from its edge point to the face point
+    child.edgeVerts.resize(2 * (2 * E + H));
+    child.edgeFaces.assign(2 * (2 * E + H), kInvalid);
+    child.faceStart.resize(H + 1);
+    child.corners.resize(4 * H);
+    child.cornerEdge.resize(4 * H);
+
+    parallelFor(E, threads, [&](size_t begin, size_t end)
+    {
+        for (size_t e = begin; e < end; ++e)
+        {
+            const uint32_t mid = edgeBase + static_cast<uint32_t>(e);
+            child.edgeVerts[4 * e + 0] = cage.edgeVerts[2 * e];
+            child.edgeVerts[4 * e + 1] = mid;
+            child.edgeVerts[4 * e + 2] = mid;
+            child.edgeVerts[4 * e + 3] = cage.edgeVerts[2 * e + 1];
+        }
+    });
+
+    auto childEdge = [&](uint32_t e, uint32_t v)
+    {
+        return cage.edgeVerts[2 * e] == v ? 2 * e : 2 * e + 1;
+    };
+
+    // every corner becomes the quad (vertex, next edge point, face point, previous edge point)
+    parallelFor(F, threads, [&](size_t begin, size_t end)
+    {
+        for (size_t f = begin; f < end; ++f)
+        {
+            const uint32_t start = cage.faceStart[f];
+            const uint32_t stop = cage.faceStart[f + 1];
+            const uint32_t center = faceBase + static_cast<uint32_t>(f);
+
+            for (uint32_t c = start; c < stop; ++c)
+            {
+                const uint32_t prev = c == start ? stop - 1 : c - 1;
+                const uint32_t next = c + 1 == stop ? start : c + 1;
+                const uint32_t v = cage.corners[c];
+                const uint32_t e = cage.cornerEdge[c];
+                const uint32_t ePrev = cage.cornerEdge[prev];
+
+                child.faceStart[c] = 4 * c;
+                child.corners[4 * c + 0] = v;
+                child.corners[4 * c + 1] = edgeBase + e;
+                child.corners[4 * c + 2] = center;
+                child.corners[4 * c + 3] = edgeBase + ePrev;
+
+                const uint32_t inner = static_cast<uint32_t>(2 * E) + c;
+                child.cornerEdge[4 * c + 0] = childEdge(e, v);
+                child.cornerEdge[4 * c + 1] = inner;
+                child.cornerEdge[4 * c + 2] = static_cast<uint32_t>(2 * E) + prev;
+                child.cornerEdge[4 * c + 3] = childEdge(ePrev, v);
+
+                // inner edge : between this corner's quad and the next corner's
+                child.edgeVerts[2 * inner] = edgeBase + e;
+                child.edgeVerts[2 * inner + 1] = center;
+                child.edgeFaces[2 * inner] = c;
+                child.edgeFaces[2 * inner + 1] = next;
+
+                // the halves of edge e keep the slot face f had on it
+                const uint32_t slot = cage.edgeFaces[2 * e] == f ? 0 : cage.edgeFaces[2 * e + 1] == f ? 1 : 2;
+                if (slot < 2)
+                {
+                    child.edgeFaces[2 * childEdge(e, v) + slot] = c;
+                    child.edgeFaces[2 * childEdge(e, cage.corners[next]) + slot] = next;
+                }
+            }
+        }
+    });
+    child.faceStart[H] = static_cast<uint32_t>(4 * H);
+
+    return child;
+}
+
+MeshSubdivision::Cage MeshSubdivision::subdivide(const MeshTopology& topo, int levels, unsigned threads)
+{
+    Cage cage = fromTopology(topo);
+    for (int level = 0; level < levels; ++level)
+        cage = refine(cage, threads);
+    return cage;
+}
+
+const MeshSubdivision::Cage& MeshSubdivision::preview(const MeshTopology& topo, int levels)
+{
+    if (builtTopologyBuild == topo.getBuildCount()
+        && builtPositionsVersion == topo.getPositionsVersion()
+        && builtLevels == levels)
+    {
+        return cached;
+    }
+
+    cached = subdivide(topo, levels);
+    builtTopologyBuild = topo.getBuildCount();
+    builtPositionsVersion = topo.getPositionsVersion();
+    builtLevels = levels;
+    return cached;
+}
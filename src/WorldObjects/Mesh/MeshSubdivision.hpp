@@ -0,0 +1,50 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class MeshTopology;
+
+// Catmull-Clark subdivision over flat index arrays. Face, edge and vertex
+// points of a level are computed in data-parallel passes split across worker
+// threads, then the refined connectivity is written in bulk : every corner of
+// a parent face becomes one child quad, so no edge lookup is needed past the
+// cage read from the MeshTopology. Edges without faces are left out.
+class MeshSubdivision
+{
+public:
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    // polygon cage; after one level every face is a quad
+    struct Cage
+    {
+        std::vector<glm::vec3> points;
+        std::vector<uint32_t> faceStart;   // face f owns corners [faceStart[f], faceStart[f + 1])
+        std::vector<uint32_t> corners;     // vertex at each corner
+        std::vector<uint32_t> cornerEdge;  // edge from each corner to the next one
+        std::vector<uint32_t> edgeVerts;   // start and end of each edge
+        std::vector<uint32_t> edgeFaces;   // two faces per edge, kInvalid on the border
+
+        size_t vertexCount() const { return points.size(); }
+        size_t edgeCount() const { return edgeVerts.size() / 2; }
+        size_t faceCount() const { return faceStart.empty() ? 0 : faceStart.size() - 1; }
+    };
+
+    // cage vertex v is topology vertex v, at every level
+    static Cage fromTopology(const MeshTopology& topo);
+
+    // one Catmull-Clark step; threads 0 uses every hardware thread
+    static Cage refine(const Cage& cage, unsigned threads = 0);
+
+    static Cage subdivide(const MeshTopology& topo, int levels, unsigned threads = 0);
+
+    // preview kept until the topology is rebuilt, vertices move or the level changes
+    const Cage& preview(const MeshTopology& topo, int levels);
+
+private:
+    Cage cached;
+    uint64_t builtTopologyBuild = UINT64_MAX;
+    uint64_t builtPositionsVersion = UINT64_MAX;
+    int builtLevels = -1;
+};
@@ -0,0 +1,249 @@
+#include "WorldObjects/Mesh/MeshTopology.hpp"
+#include "WorldObjects/Mesh/Mesh.hpp"
+#include <unordered_map>
+#include <utility>
+
+static uint64_t vertexPairKey(uint32_t a, uint32_t b)
+{
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+void MeshTopology::sync(const Mesh& mesh)
+{
+    if (builtTopologyVersion != mesh.getTopologyVersion()
+        || builtVertexCount != mesh.vertexCount()
+        || builtEdgeCount != mesh.edgeCount()
+        || builtFaceCount != mesh.faceCount())
+    {
+        rebuild(mesh);
+    }
+    else if (positionsDirty)
+    {
+        refreshPositions();
+    }
+}
+
+void MeshTopology::rebuild(const Mesh& mesh)
+{
+    // ---- elements ---- //
+    vertices.clear();
+    for (Vertice* v : mesh.getVertices())
+    {
+        if (!v) continue;
+        v->setTopologySlot(static_cast<uint32_t>(vertices.size()));
+        vertices.push_back(v);
+    }
+
+    std::unordered_map<uint64_t, uint32_t> edgeByPair;
+    edgeByPair.reserve(mesh.edgeCount());
+
+    edges.clear();
+    for (Edge* e : mesh.getEdges())
+    {
+        if (!e) continue;
+        const uint32_t a = handleOf(e->getStart());
+        const uint32_t b = handleOf(e->getEnd());
+        if (a == kInvalid || b == kInvalid) continue;
+
+        e->setTopologySlot(static_cast<uint32_t>(edges.size()));
+        edgeByPair.emplace(vertexPairKey(a, b), static_cast<uint32_t>(edges.size()));
+        edges.push_back(e);
+    }
+
+    faces.clear();
+    quads.clear();
+    heVertex.clear();
+    heNext.clear();
+    hePrev.clear();
+    heFace.clear();
+    heEdge.clear();
+    faceFirstHalfEdge.clear();
+    faceSides.clear();
+
+    // ---- one half-edge per face side ---- //
+    for (Face* f : mesh.getFaces())
+    {
+        if (!f) continue;
+        const auto& verts = f->getVertices();
+        const uint32_t n = static_cast<uint32_t>(verts.size());
+        if (n < 3) continue;
+
+        bool complete = true;
+        for (Vertice* v : verts)
+            complete = complete && handleOf(v) != kInvalid;
+        if (!complete) continue;
+
+        const uint32_t faceHandle = static_cast<uint32_t>(faces.size());
+        const uint32_t base = static_cast<uint32_t>(heVertex.size());
+        f->setTopologySlot(faceHandle);
+        faces.push_back(f);
+        quads.push_back(f->isQuad() ? static_cast<Quad*>(f) : nullptr);
+        faceFirstHalfEdge.push_back(base);
+        faceSides.push_back(n);
+
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            Vertice* from = verts[i];
+            Vertice* to = verts[(i + 1) % n];
+
+            // prefer the face's own edge, the pair lookup covers faces built without edges
+            uint32_t edgeHandle = kInvalid;
+            for (Edge* e : f->getEdges())
+            {
+                if (e && ((e->getStart() == from && e->getEnd() == to) || (e->getStart() == to && e->getEnd() == from)))
+                {
+                    edgeHandle = handleOf(e);
+                    break;
+                }
+            }
+            if (edgeHandle == kInvalid)
+            {
+                auto it = edgeByPair.find(vertexPairKey(handleOf(from), handleOf(to)));
+                if (it != edgeByPair.end())
+                    edgeHandle = it->second;
+            }
+
+            heVertex.push_back(handleOf(from));
+            heNext.push_back(base + (i + 1) % n);
+            hePrev.push_back(base + (i + n - 1) % n);
+            heFace.push_back(faceHandle);
+            heEdge.push_back(edgeHandle);
+        }
+    }
+
+    // ---- radial cycles around each edge ---- //
+    const uint32_t halfEdges = halfEdgeCount();
+    heRadial.resize(halfEdges);
+    edgeFirstHalfEdge.assign(edges.size(), kInvalid);
+    for (uint32_t he = 0; he < halfEdges; ++he)
+    {
+        const uint32_t e = heEdge[he];
+        heRadial[he] = he;
+        if (e == kInvalid) continue;
+
+        uint32_t& first = edgeFirstHalfEdge[e];
+        if (first == kInvalid)
+        {
+            first = he;
+        }
+        else
+        {
+            heRadial[he] = heRadial[first];
+            heRadial[first] = he;
+        }
+    }
+
+    // boundary half-edges win so walks around a vertex can start at the border
+    vertHalfEdge.assign(vertices.size(), kInvalid);
+    for (uint32_t he = 0; he < halfEdges; ++he)
+    {
+        uint32_t& slot = vertHalfEdge[heVertex[he]];
+        if (slot == kInvalid || twin(he) == kInvalid)
+            slot = he;
+    }
+
+    refreshPositions();
+
+    builtTopologyVersion = mesh.getTopologyVersion();
+    builtVertexCount = mesh.vertexCount();
+    builtEdgeCount = mesh.edgeCount();
+    builtFaceCount = mesh.faceCount();
+    ++buildCount;
+}
+
+void MeshTopology::refreshPositions()
+{
+    const size_t count = vertices.size();
+    posX.resize(count);
+    posY.resize(count);
+    posZ.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const glm::vec3 p = vertices[i]->getLocalPosition();
+        posX[i] = p.x;
+        posY[i] = p.y;
+        posZ[i] = p.z;
+    }
+    positionsDirty = false;
+    ++positionsVersion;
+}
+
+// ---- lookups ---- //
+
+uint32_t MeshTopology::handleOf(const Vertice* v) const
+{
+    if (!v) return kInvalid;
+    const uint32_t slot = v->getTopologySlot();
+    return slot < vertices.size() && vertices[slot] == v ? slot : kInvalid;
+}
+
+uint32_t MeshTopology::handleOf(const Edge* e) const
+{
+    if (!e) return kInvalid;
+    const uint32_t slot = e->getTopologySlot();
+    return slot < edges.size() && edges[slot] == e ? slot : kInvalid;
+}
+
+uint32_t MeshTopology::handleOf(const Face* f) const
+{
+    if (!f) return kInvalid;
+    const uint32_t slot = f->getTopologySlot();
+    return slot < faces.size() && faces[slot] == f ? slot : kInvalid;
+}
+
+bool MeshTopology::isBoundary(uint32_t e) const
+{
+    const uint32_t he = edgeFirstHalfEdge[e];
+    return he == kInvalid || heRadial[he] == he;
+}
+
+uint32_t MeshTopology::halfEdgeInFace(uint32_t e, uint32_t f) const
+{
+    const uint32_t first = faceFirstHalfEdge[f];
+    for (uint32_t i = 0; i < faceSides[f]; ++i)
+    {
+        if (heEdge[first + i] == e)
+            return first + i;
+    }
+    return kInvalid;
+}
+
+uint32_t MeshTopology::oppositeEdgeInQuad(uint32_t e, uint32_t f) const
+{
+    if (faceSides[f] != 4)
+        return kInvalid;
+
+    const uint32_t he = halfEdgeInFace(e, f);
+    return he == kInvalid ? kInvalid : heEdge[heNext[heNext[he]]];
+}
+
+uint32_t MeshTopology::sharedFace(uint32_t a, uint32_t b) const
+{
+    const uint32_t start = edgeFirstHalfEdge[a];
+    if (start == kInvalid)
+        return kInvalid;
+
+    uint32_t he = start;
+    do
+    {
+        if (halfEdgeInFace(b, heFace[he]) != kInvalid)
+            return heFace[he];
+        he = heRadial[he];
+    } while (he != start);
+
+    return kInvalid;
+}
+
+glm::vec3 MeshTopology::centroid() const
+{
+    const size_t count = posX.size();
+    if (count == 0)
+        return glm::vec3(0.0f);
+
+    float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+    for (size_t i = 0; i < count; ++i) sx += posX[i];
+    for (size_t i = 0; i < count; ++i) sy += posY[i];
+    for (size_t i = 0; i < count; ++i) sz += posZ[i];
+    return glm::vec3(sx, sy, sz) / static_cast<float>(count);
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+class Mesh;
+class Vertice;
+class Edge;
+class Face;
+class Quad;
+
+// Indexed half-edge view of a mesh : every vertex, edge and face gets a
+// dense uint32 handle, positions are kept as structure-of-arrays and the
+// connectivity lives in flat arrays, so next / twin / vertex / face are
+// single loads. Rebuilt from the element graph when the topology version
+// changes; positions are refreshed in place when vertices only moved.
+//
+// Each face side is one half-edge. All half-edges lying on the same edge
+// form a radial cycle, which reduces to the usual twin on manifold edges
+// and still reaches every face of a non-manifold one.
+class MeshTopology
+{
+public:
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    void sync(const Mesh& mesh);
+    void markPositionsDirty() { positionsDirty = true; }
+
+    // bumped on every rebuild, caches derived from the connectivity key on it
+    uint64_t getBuildCount() const { return buildCount; }
+
+    // bumped whenever the positions are re-read, rebuilds included
+    uint64_t getPositionsVersion() const { return positionsVersion; }
+
+    uint32_t vertexCount() const { return static_cast<uint32_t>(vertices.size()); }
+    uint32_t edgeCount() const { return static_cast<uint32_t>(edges.size()); }
+    uint32_t faceCount() const { return static_cast<uint32_t>(faces.size()); }
+    uint32_t halfEdgeCount() const { return static_cast<uint32_t>(heVertex.size()); }
+
+    // ---- handle <-> element ---- //
+    Vertice* vertice(uint32_t v) const { return vertices[v]; }
+    Edge* edge(uint32_t e) const { return edges[e]; }
+    Face* face(uint32_t f) const { return faces[f]; }
+    Quad* quad(uint32_t f) const { return quads[f]; }
+
+    // kInvalid when the element is not part of the last build
+    uint32_t handleOf(const Vertice* v) const;
+    uint32_t handleOf(const Edge* e) const;
+    uint32_t handleOf(const Face* f) const;
+
+    // ---- half-edge queries ---- //
+    uint32_t next(uint32_t he) const { return heNext[he]; }
+    uint32_t prev(uint32_t he) const { return hePrev[he]; }
+    uint32_t radial(uint32_t he) const { return heRadial[he]; }
+    uint32_t twin(uint32_t he) const { return heRadial[he] != he ? heRadial[he] : kInvalid; }
+    uint32_t origin(uint32_t he) const { return heVertex[he]; }
+    uint32_t target(uint32_t he) const { return heVertex[heNext[he]]; }
+    uint32_t faceOf(uint32_t he) const { return heFace[he]; }
+    uint32_t edgeOf(uint32_t he) const { return heEdge[he]; }
+
+    uint32_t vertexHalfEdge(uint32_t v) const { return vertHalfEdge[v]; }
+    uint32_t edgeHalfEdge(uint32_t e) const { return edgeFirstHalfEdge[e]; }
+    uint32_t faceHalfEdge(uint32_t f) const { return faceFirstHalfEdge[f]; }
+    uint32_t faceSize(uint32_t f) const { return faceSides[f]; }
+
+    bool isBoundary(uint32_t e) const;
+
+    // half-edge of edge e inside face f, kInvalid when f does not use e
+    uint32_t halfEdgeInFace(uint32_t e, uint32_t f) const;
+
+    // edge across quad f from edge e (sharing no vertex), kInvalid otherwise
+    uint32_t oppositeEdgeInQuad(uint32_t e, uint32_t f) const;
+
+    // first face holding both edges, kInvalid when none
+    uint32_t sharedFace(uint32_t a, uint32_t b) const;
+
+    // ---- structure-of-arrays positions (mesh local space) ---- //
+    glm::vec3 position(uint32_t v) const { return glm::vec3(posX[v], posY[v], posZ[v]); }
+    glm::vec3 centroid() const;
+
+private:
+    void rebuild(const Mesh& mesh);
+    void refreshPositions();
+
+    uint64_t builtTopologyVersion = UINT64_MAX;
+    size_t builtVertexCount = 0;
+    size_t builtEdgeCount = 0;
+    size_t builtFaceCount = 0;
+    bool positionsDirty = true;
+    uint64_t buildCount = 0;
+    uint64_t positionsVersion = 0;
+
+    std::vector<Vertice*> vertices;
+    std::vector<Edge*> edges;
+    std::vector<Face*> faces;
+    std::vector<Quad*> quads;  // nullptr for faces that are not Quad
+
+    std::vector<float> posX, posY, posZ;
+
+    std::vector<uint32_t> heVertex;  // origin vertex
+    std::vector<uint32_t> heNext;
+    std::vector<uint32_t> hePrev;
+    std::vector<uint32_t> heRadial;  // next half-edge on the same edge
+    std::vector<uint32_t> heFace;
+    std::vector<uint32_t> heEdge;
+
+    std::vector<uint32_t> vertHalfEdge;       // one outgoing half-edge, boundary first
+    std::vector<uint32_t> edgeFirstHalfEdge;
+    std::vector<uint32_t> faceFirstHalfEdge;
+    std::vector<uint32_t> faceSides;
+};
@@ -5,6 +5,7 @@
 #include <glm/gtc/matrix_inverse.hpp>
 #include <iostream>
 #include <algorithm>
+#include <unordered_map>
 #include <iomanip> 
 #include "Engine/ErrorBox.hpp"
 
@@ -26,18 +27,6 @@ void MeshDNA::clear()
 }
 
 
-static void recomputeWorldFromLocal(Mesh* mesh)
-{
-    if (!mesh) return;
-    const glm::mat4 P = mesh->getModelMatrix();
-    for (Vertice* v : mesh->getVertices())
-    {
-        if (!v) continue;
-        glm::vec4 W = P * glm::vec4(v->getLocalPosition(), 1.0f);
-        v->setPosition(glm::vec3(W));
-    }
-}
-
 static glm::mat4 modelFromFreezeUpTo(const std::vector<MeshTransformEvent>& history,
 size_t index_inclusive, const glm::mat4& frozenModel, bool hasFrozen)
 {
@@ -78,12 +67,11 @@ void MeshDNA::rewindToAndApply(size_t index_inclusive, Mesh* mesh)
     else 
     {
         mesh->setModelMatrix(glm::mat4(1.0f));
-        recomputeWorldFromLocal(mesh);
     }
 
+    // world positions follow the model matrix, no per-vertex pass needed
     glm::mat4 M = modelFromFreezeUpTo(history, index_inclusive, frozenModelMatrix, hasFrozen);
     mesh->setModelMatrix(M);
-    recomputeWorldFromLocal(mesh);
 
     history.resize(index_inclusive + 1);
 
@@ -114,7 +102,15 @@ void MeshDNA::track(const glm::mat4& delta, uint64_t tick, const std::string& ta
     if (ev.tick >= nextTick) nextTick = ev.tick + 1;
 }
 
-void MeshDNA::trackEdgeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts) 
+// a move event keeps its vertices as refs, a weld or a dissolve after it may free them
+static void stampVertices(MeshTransformEvent& ev, const std::vector<Vertice*>& verts, const Mesh* mesh)
+{
+    ev.affectedVertices.reserve(verts.size());
+    for (Vertice* v : verts)
+        ev.affectedVertices.push_back(mesh->makeRef(v));
+}
+
+void MeshDNA::trackEdgeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts, const Mesh* mesh) 
 {
     MeshTransformEvent ev;
     ev.delta = deltaWorld;
@@ -122,12 +118,12 @@ void MeshDNA::trackEdgeModify(const glm::mat4& deltaWorld, const std::vector<Ver
     ev.tag = "edge_modify";
     ev.isComponentEdit = true;
     ev.kind  = ComponentEditKind::Edge;  
-    ev.affectedVertices = verts;
+    stampVertices(ev, verts, mesh);
 
     history.push_back(std::move(ev));
 }
 
-void MeshDNA::trackVerticeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts)
+void MeshDNA::trackVerticeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts, const Mesh* mesh)
 {
     MeshTransformEvent ev;
     ev.delta = deltaWorld;
@@ -135,7 +131,7 @@ void MeshDNA::trackVerticeModify(const glm::mat4& deltaWorld, const std::vector<
     ev.tag   = "vertex_modify";
     ev.isComponentEdit = true; 
     ev.kind  = ComponentEditKind::Vertice;
-    ev.affectedVertices = verts;
+    stampVertices(ev, verts, mesh);
     history.push_back(std::move(ev));
 }
 
@@ -157,7 +153,7 @@ void MeshDNA::trackWithTransformID(const glm::mat4& delta, const std::string& ta
     
 }
 
-void MeshDNA::trackExtrude(const ExtrudeRecord& rec)
+void MeshDNA::trackExtrude(ExtrudeRecord rec)
 {
     MeshTransformEvent ev;
     ev.delta = glm::mat4(1.0f);
@@ -165,17 +161,26 @@ void MeshDNA::trackExtrude(const ExtrudeRecord& rec)
     ev.tag   = "extrude_face";
     ev.isComponentEdit = true;
     ev.kind  = ComponentEditKind::Extrude;
-    ev.extrude = rec; 
+    ev.extrude = std::move(rec);
 
     history.push_back(std::move(ev));
 }
 
-
-static void erasePtr(std::vector<Vertice*>& v, Vertice* p) 
+void MeshDNA::trackTopologyEdit(const std::string& tag, TopologyEditRecord rec)
 {
-    v.erase(std::remove(v.begin(), v.end(), p), v.end());
+    MeshTransformEvent ev;
+    ev.delta = glm::mat4(1.0f);
+    ev.tick  = nextTick++;
+    ev.tag   = tag;
+    ev.isComponentEdit = true;
+    ev.kind  = ComponentEditKind::Topology;
+    ev.topology = std::move(rec);
+
+    history.push_back(std::move(ev));
 }
-static void erasePtr(std::vector<Edge*>& v, Edge* p) 
+
+
+static void erasePtr(std::vector<Vertice*>& v, Vertice* p) 
 {
     v.erase(std::remove(v.begin(), v.end(), p), v.end());
 }
@@ -215,7 +220,6 @@ void MeshDNA::freezeFromMesh(const Mesh* mesh)
         SnapshotVertice snap;
         snap.ptr   = v;
         snap.local = v->getLocalPosition();
-        snap.world = v->getPosition(); 
         frozenVertices.push_back(snap);
     }
     hasFrozen = true;
@@ -246,10 +250,6 @@ void MeshDNA::resetToFreeze(Mesh* mesh) const
         if (!snap.ptr) continue;
 
         snap.ptr->setLocalPosition(snap.local);
-
-        const glm::mat4 P = mesh->getModelMatrix();
-        glm::vec4 W = P * glm::vec4(snap.local, 1.0f);
-        snap.ptr->setPosition(glm::vec3(W));
     }
 }
 
@@ -273,114 +273,23 @@ glm::mat4 MeshDNA::accumulatedUpTo(size_t count) const
 }
 
 
-void MeshDNA::rewindEdgeHistory(size_t index_inclusive, Mesh* mesh)
+// drops the events after index_inclusive that match, keeping the order of the rest
+template <typename Pred>
+static void dropEventsAfter(std::vector<MeshTransformEvent>& history, size_t index_inclusive, Pred drop)
 {
-
-    if (!mesh) return;
-    if (history.empty()) { acc = glm::mat4(1.0f); return; }
-    if (index_inclusive + 1 > history.size()) return;
-
-    for (size_t k = history.size(); k-- > index_inclusive + 1; ) 
-    {
-        const auto& ev = history[k];
-        if (ev.kind == ComponentEditKind::Edge) 
-        {
-            const glm::mat4 invDelta = glm::inverse(ev.delta);
-            for (auto* vtx : ev.affectedVertices) 
-            {
-                if (!vtx) continue;
-                ThreeDObject* parent = vtx->getMeshParent();
-                if (!parent) continue;
-
-                const glm::mat4 P = parent->getModelMatrix();
-                const glm::mat4 Pi = glm::inverse(P);
-
-                glm::vec4 L  = glm::vec4(vtx->getLocalPosition(), 1.0f);
-                glm::vec4 W2 = invDelta * (P * L);
-                glm::vec4 L2 = Pi * W2;
-
-                vtx->setLocalPosition(glm::vec3(L2));
-                vtx->setPosition(glm::vec3(W2));
-            }
-        }
-    }
-
     size_t write = 0;
-
-    for (size_t idx = 0; idx < history.size(); ++idx) 
-    {
-        bool drop = (idx > index_inclusive) && (history[idx].kind == ComponentEditKind::Edge);
-        if (!drop) {
-            history[write++] = std::move(history[idx]);
-        }
-    }
-    history.resize(write);
-
-    acc = glm::mat4(1.0f);
-    for (const auto& ev : history)
-    {
-        if (ev.kind != ComponentEditKind::None) continue;
-        if (hasFrozen && isInitEvent(ev)) continue; 
-        acc = ev.delta * acc;
-    }
-
-    nextTick = history.empty() ? 0 : history.back().tick + 1;
-}
-
-
-void MeshDNA::rewindVerticeHistory(size_t index_inclusive, Mesh* mesh)
-{
-
-    if (!mesh) return;
-    if (history.empty()) { acc = glm::mat4(1.0f); return; }
-    if (index_inclusive + 1 > history.size()) return;
-
-    for (size_t k = history.size(); k-- > index_inclusive + 1; ) 
-    {
-        const auto& ev = history[k];
-        if (ev.kind == ComponentEditKind::Vertice)
-        {
-            const glm::mat4 invDelta = glm::inverse(ev.delta);
-            for (auto* vtx : ev.affectedVertices) 
-            {
-                if (!vtx) continue;
-                ThreeDObject* parent = vtx->getMeshParent();
-                if (!parent) continue;
-
-                const glm::mat4 P  = parent->getModelMatrix();
-                const glm::mat4 Pi = glm::inverse(P);
-
-                glm::vec4 L  = glm::vec4(vtx->getLocalPosition(), 1.0f);
-                glm::vec4 W2 = invDelta * (P * L);
-                glm::vec4 L2 = Pi * W2;
-
-                vtx->setLocalPosition(glm::vec3(L2));
-                vtx->setPosition(glm::vec3(W2));
-            }
-        }
-    }
-
-    size_t write = 0;
-    for (size_t idx = 0; idx < history.size(); ++idx) 
+    for (size_t idx = 0; idx < history.size(); ++idx)
     {
-        bool drop = (idx > index_inclusive) && (history[idx].kind == ComponentEditKind::Vertice);
-        if (!drop) {
-            history[write++] = std::move(history[idx]);
-        }
+        if (idx > index_inclusive && drop(history[idx])) continue;
+        // an event moved onto itself would come out with empty record vectors
+        if (write != idx)
+            history[write] = std::move(history[idx]);
+        ++write;
     }
     history.resize(write);
-
-    acc = glm::mat4(1.0f);
-    for (const auto& ev : history) 
-    {
-        if (ev.kind == ComponentEditKind::None)
-            acc = ev.delta * acc;
-    }
-
-    nextTick = history.empty() ? 0 : history.back().tick + 1;
 }
 
-void MeshDNA::trackFaceModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts)
+void MeshDNA::trackFaceModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts, const Mesh* mesh)
 {
     MeshTransformEvent ev;
     ev.delta = deltaWorld;
@@ -388,150 +297,140 @@ void MeshDNA::trackFaceModify(const glm::mat4& deltaWorld, const std::vector<Ver
     ev.tag   = "face_modify";
     ev.isComponentEdit = true;
     ev.kind  = ComponentEditKind::Face;
-    ev.affectedVertices = verts;
+    stampVertices(ev, verts, mesh);
     history.push_back(std::move(ev));
 }
 
-
-void MeshDNA::rewindFaceHistory(size_t index_inclusive, Mesh* mesh)
+// moves an edge / vertex / face event's vertices back; freed ones resolve to nullptr
+static void undoMove(const MeshTransformEvent& ev, Mesh* mesh)
 {
-    if (!mesh) return;
-    if (history.empty()) { acc = glm::mat4(1.0f); return; }
-    if (index_inclusive + 1 > history.size()) return;
-
-
-    for (size_t k = history.size(); k-- > index_inclusive + 1; )
+    const glm::mat4 invDelta = glm::inverse(ev.delta);
+    for (const auto& ref : ev.affectedVertices)
     {
-        const auto& ev = history[k];
-        if (ev.kind == ComponentEditKind::Face)
-        {
-            const glm::mat4 invDelta = glm::inverse(ev.delta);
-            for (auto* vtx : ev.affectedVertices)
-            {
-                if (!vtx) continue;
-                ThreeDObject* parent = vtx->getMeshParent();
-                if (!parent) continue;
-
-                const glm::mat4 P  = parent->getModelMatrix();
-                const glm::mat4 Pi = glm::inverse(P);
-
-                glm::vec4 L  = glm::vec4(vtx->getLocalPosition(), 1.0f);
-                glm::vec4 W2 = invDelta * (P * L);
-                glm::vec4 L2 = Pi * W2;
-
-                vtx->setLocalPosition(glm::vec3(L2));
-                vtx->setPosition(glm::vec3(W2));
-            }
-        }
-    }
+        Vertice* vtx = mesh->resolve(ref);
+        if (!vtx) continue;
+        ThreeDObject* parent = vtx->getMeshParent();
+        if (!parent) continue;
 
+        const glm::mat4 P  = parent->getModelMatrix();
+        const glm::mat4 Pi = glm::inverse(P);
 
-    size_t write = 0;
-    for (size_t idx = 0; idx < history.size(); ++idx)
-    {
-        bool drop = (idx > index_inclusive) && (history[idx].kind == ComponentEditKind::Face);
-        if (!drop) history[write++] = std::move(history[idx]);
-    }
-    history.resize(write);
+        glm::vec4 L  = glm::vec4(vtx->getLocalPosition(), 1.0f);
+        glm::vec4 W2 = invDelta * (P * L);
+        glm::vec4 L2 = Pi * W2;
 
-    acc = glm::mat4(1.0f);
-    for (const auto& ev : history)
-        if (ev.kind == ComponentEditKind::None)
-            acc = ev.delta * acc;
-
-    nextTick = history.empty() ? 0 : history.back().tick + 1;
+        vtx->setLocalPosition(glm::vec3(L2));
+    }
 }
 
-void MeshDNA::rewindExtrudeHistory(size_t index_inclusive, Mesh* mesh)
+// puts the mesh back as it was before one extrusion
+static void undoExtrude(const ExtrudeRecord& rec, Mesh* mesh)
 {
-    if (!mesh) return;
-    if (history.empty()) { acc = glm::mat4(1.0f); return; }
-    if (index_inclusive + 1 > history.size()) return;
-
     auto& V = const_cast<std::vector<Vertice*>&>(mesh->getVertices());
     auto& E = const_cast<std::vector<Edge*>&>(mesh->getEdges());
     auto& F = const_cast<std::vector<Face*>&>(mesh->getFaces());
 
+    // removed elements go back to the mesh's pools, so refs to them resolve to nullptr
     auto removeFace = [&](Face* f){
         if (!f) return;
         if (std::find(F.begin(), F.end(), f) == F.end()) return; 
         erasePtr(F, f);
+        f->unlinkAdjacency();
         if constexpr (has_destroy<Face>::value) f->destroy();
+        mesh->freeFace(f);
     };
     auto removeEdge = [&](Edge* e){
         if (!e) return;
         if (std::find(E.begin(), E.end(), e) == E.end()) return;
-        erasePtr(E, e);
+        // up edges are also listed on the old vertices, which stay
+        if (e->getStart()) e->getStart()->removeEdge(e);
+        if (e->getEnd()) e->getEnd()->removeEdge(e);
+        mesh->detachEdge(e);
         if constexpr (has_destroy<Edge>::value) e->destroy();
+        mesh->freeEdge(e);
     };
     auto removeVert = [&](Vertice* v){
         if (!v) return;
         if (std::find(V.begin(), V.end(), v) == V.end()) return;
         erasePtr(V, v);
         if constexpr (has_destroy<Vertice>::value) v->destroy();
+        mesh->freeVertice(v);
     };
 
-    for (size_t k = history.size(); k-- > index_inclusive + 1; ) 
-    {
-        auto& ev = history[k];
-        if (ev.kind != ComponentEditKind::Extrude) continue;
+    // stale refs resolve to nullptr : the element was freed, or its slot reused
+    for (const auto& s : rec.sideFaces) removeFace(mesh->resolve(s));
+    for (const auto& c : rec.capFaces) removeFace(mesh->resolve(c));
 
-  
-        for (Face* s : ev.extrude.sideFaces) removeFace(s);
-        removeFace(ev.extrude.capFace);
+    for (const auto& ce : rec.capEdges) removeEdge(mesh->resolve(ce));
+    for (const auto& ue : rec.upEdges)  removeEdge(mesh->resolve(ue));
 
-        for (Edge* ce : ev.extrude.capEdges) removeEdge(ce);
-        for (Edge* ue : ev.extrude.upEdges)  removeEdge(ue);
 
+    for (const auto& nv : rec.newVerts) removeVert(mesh->resolve(nv));
 
-        for (Vertice* nv : ev.extrude.newVerts) removeVert(nv);
+    for (size_t i = 0; i < rec.movedVerts.size(); ++i)
+    {
+        if (Vertice* v = mesh->resolve(rec.movedVerts[i]))
+            v->setLocalPosition(v->getLocalPosition() - rec.movedBy[i]);
+    }
 
-        if (ev.extrude.oldVerts[0] && ev.extrude.oldVerts[1] &&
-        ev.extrude.oldVerts[2] && ev.extrude.oldVerts[3] &&
-        ev.extrude.oldEdges[0] && ev.extrude.oldEdges[1] &&
-        ev.extrude.oldEdges[2] && ev.extrude.oldEdges[3])
+    // ---- the region faces come back over their old vertices ---- //
+    std::vector<Vertice*> vs;
+    std::vector<Edge*> es;
+    size_t first = 0;
+    for (uint32_t sides : rec.oldSides)
+    {
+        vs.clear();
+        es.clear();
+        bool oldAlive = true;
+        for (uint32_t i = 0; i < sides; ++i)
         {
-            bool already = std::find_if(F.begin(), F.end(), [&](Face* f)
-            {
-                if (!f) return false;
-                const auto& vs = f->getVertices();
-                const auto& es = f->getEdges();
-
-                return vs.size()==4 && es.size()==4 &&
-                vs[0]==ev.extrude.oldVerts[0] &&
-                vs[1]==ev.extrude.oldVerts[1] &&
-                vs[2]==ev.extrude.oldVerts[2] &&
-                vs[3]==ev.extrude.oldVerts[3] &&
-                es[0]==ev.extrude.oldEdges[0] &&
-                es[1]==ev.extrude.oldEdges[1] &&
-                es[2]==ev.extrude.oldEdges[2] &&
-                es[3]==ev.extrude.oldEdges[3];
-            }) != F.end();
-
-            if (!already) 
-            {
-                Face* restored = mesh->addFace(
-                    ev.extrude.oldVerts[0],
-                    ev.extrude.oldVerts[1],
-                    ev.extrude.oldVerts[2],
-                    ev.extrude.oldVerts[3],
-                    ev.extrude.oldEdges[0],
-                    ev.extrude.oldEdges[1],
-                    ev.extrude.oldEdges[2],
-                    ev.extrude.oldEdges[3]
-                );
-            }
+            Vertice* v = mesh->resolve(rec.oldVerts[first + i]);
+            oldAlive = oldAlive && v;
+            vs.push_back(v);
         }
+        const size_t at = first;
+        first += sides;
+        if (!oldAlive || sides < 3) continue;
+
+        // edges the extrusion retired are recorded null and made again
+        for (uint32_t i = 0; i < sides; ++i)
+        {
+            Vertice* a = vs[i];
+            Vertice* b = vs[(i + 1) % sides];
+            Edge* e = mesh->resolve(rec.oldEdges[at + i]);
+            if (!e) e = mesh->findEdge(a, b);
+            if (!e) e = mesh->addEdge(a, b);
+            es.push_back(e);
+        }
+
+        bool already = std::find_if(F.begin(), F.end(), [&](Face* f)
+        {
+            return f && f->getVertices() == vs && f->getEdges() == es;
+        }) != F.end();
+        if (already) continue;
+
+        if (sides == 4)
+            mesh->addFace(vs[0], vs[1], vs[2], vs[3], es[0], es[1], es[2], es[3]);
+        else if (sides == 3)
+            mesh->addTriangle(vs[0], vs[1], vs[2], es[0], es[1], es[2]);
+        else
+            mesh->addNgon(vs, es);
     }
+}
 
-  
-    size_t write = 0;
-    for (size_t idx = 0; idx < history.size(); ++idx) 
+void MeshDNA::rewindExtrudeHistory(size_t index_inclusive, Mesh* mesh)
+{
+    if (!mesh) return;
+    if (history.empty()) { acc = glm::mat4(1.0f); return; }
+    if (index_inclusive + 1 > history.size()) return;
+
+    for (size_t k = history.size(); k-- > index_inclusive + 1; ) 
     {
-        bool drop = (idx > index_inclusive) && (history[idx].kind == ComponentEditKind::Extrude);
-        if (!drop) history[write++] = std::move(history[idx]);
+        if (history[k].kind == ComponentEditKind::Extrude)
+            undoExtrude(history[k].extrude, mesh);
     }
-    history.resize(write);
+
+    dropEventsAfter(history, index_inclusive, [](const MeshTransformEvent& ev) { return ev.kind == ComponentEditKind::Extrude; });
 
 
     acc = glm::mat4(1.0f);
@@ -544,6 +443,112 @@ void MeshDNA::rewindExtrudeHistory(size_t index_inclusive, Mesh* mesh)
     nextTick = history.empty() ? 0 : history.back().tick + 1;
 }
 
+// retired element -> the ref a revert made for it, looked up by the old pointer
+template <typename T>
+using RevivedMap = std::unordered_map<const T*, std::pair<ElementRef<T>, ElementRef<T>>>;
+
+template <typename T>
+static RevivedMap<T> revivedMap(const std::vector<std::pair<ElementRef<T>, ElementRef<T>>>& revived)
+{
+    RevivedMap<T> map;
+    map.reserve(revived.size());
+    for (const auto& r : revived) map.emplace(r.first.get(), r);
+    return map;
+}
+
+// points the refs a revert retired at the copies it made; the generation has
+// to match too, the old slot may have been reused since
+template <typename T>
+static void forwardRefs(std::vector<ElementRef<T>>& refs, const RevivedMap<T>& revived)
+{
+    if (revived.empty()) return;
+    for (auto& ref : refs)
+    {
+        auto it = revived.find(ref.get());
+        if (it != revived.end() && it->second.first.generation() == ref.generation())
+            ref = it->second.second;
+    }
+}
+
+// the events before a reverted one still name what it retired
+static void forwardRevived(std::vector<MeshTransformEvent>& history, size_t before, const RevivedElements& revived)
+{
+    if (revived.verts.empty() && revived.edges.empty() && revived.faces.empty()) return;
+    const RevivedMap<Vertice> verts = revivedMap(revived.verts);
+    const RevivedMap<Edge> edges = revivedMap(revived.edges);
+    const RevivedMap<Face> faces = revivedMap(revived.faces);
+    for (size_t k = 0; k < before; ++k)
+    {
+        auto& ev = history[k];
+        if (ev.kind == ComponentEditKind::None) continue;
+        forwardRefs(ev.affectedVertices, verts);
+
+        auto& x = ev.extrude;
+        forwardRefs(x.newVerts, verts);
+        forwardRefs(x.movedVerts, verts);
+        forwardRefs(x.oldVerts, verts);
+        forwardRefs(x.capEdges, edges);
+        forwardRefs(x.upEdges, edges);
+        forwardRefs(x.oldEdges, edges);
+        forwardRefs(x.sideFaces, faces);
+        forwardRefs(x.capFaces, faces);
+
+        auto& t = ev.topology;
+        forwardRefs(t.addedVerts, verts);
+        forwardRefs(t.oldVerts, verts);
+        forwardRefs(t.oldEdgeEnds, verts);
+        forwardRefs(t.oldFaceVerts, verts);
+        forwardRefs(t.addedEdges, edges);
+        forwardRefs(t.oldEdges, edges);
+        forwardRefs(t.oldFaceEdges, edges);
+        forwardRefs(t.addedFaces, faces);
+        forwardRefs(t.oldFaces, faces);
+    }
+}
+
+void MeshDNA::rewindComponentHistory(size_t index_inclusive, Mesh* mesh)
+{
+    if (!mesh) return;
+    if (history.empty()) { acc = glm::mat4(1.0f); return; }
+    if (index_inclusive + 1 > history.size()) return;
+
+    for (size_t k = history.size(); k-- > index_inclusive + 1; )
+    {
+        const auto& ev = history[k];
+        switch (ev.kind)
+        {
+        case ComponentEditKind::Edge:
+        case ComponentEditKind::Vertice:
+        case ComponentEditKind::Face:
+            undoMove(ev, mesh);
+            break;
+        case ComponentEditKind::Extrude:
+            undoExtrude(ev.extrude, mesh);
+            break;
+        case ComponentEditKind::Topology:
+        {
+            RevivedElements revived;
+            mesh->revertTopologyEdit(ev.topology, &revived);
+            forwardRevived(history, k, revived);
+            break;
+        }
+        case ComponentEditKind::None:
+            break;
+        }
+    }
+
+    dropEventsAfter(history, index_inclusive, [](const MeshTransformEvent& ev) { return ev.kind != ComponentEditKind::None; });
+
+    acc = glm::mat4(1.0f);
+    for (const auto& ev2 : history)
+    {
+        if (ev2.kind != ComponentEditKind::None) continue;
+        if (hasFrozen && isInitEvent(ev2)) continue;
+        acc = ev2.delta * acc;
+    }
+    nextTick = history.empty() ? 0 : history.back().tick + 1;
+}
+
 bool MeshDNA::cancelTransformByID(uint64_t transformID, Mesh* mesh)
 {
     if (!mesh || transformID == 0) return false;
@@ -2,8 +2,10 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include <utility>
 #include <glm/glm.hpp>
 #include <iostream>
+#include "WorldObjects/Mesh/ElementRef.hpp"
 
 class Vertice;
 class Edge;
@@ -15,25 +17,78 @@ enum class ComponentEditKind : uint8_t {
 	Edge,
 	Vertice,
 	Face,
-	Extrude
+	Extrude,
+	Topology
 };
 
+// one record per extrusion, however many faces the region held. Elements are
+// stamped with Mesh::makeRef so a rewind skips anything that was freed (and
+// possibly reused) after the extrusion
 struct ExtrudeRecord 
 {
-	Vertice* newVerts[4]{nullptr,nullptr,nullptr,nullptr};
-	Edge* capEdges[4]{nullptr,nullptr,nullptr,nullptr};
-	Edge* upEdges[4]{nullptr,nullptr,nullptr,nullptr};
-	Face* sideFaces[4]{nullptr,nullptr,nullptr,nullptr};
-	Face* capFace{nullptr};
+	std::vector<ElementRef<Vertice>> newVerts;
+	std::vector<ElementRef<Edge>> capEdges;
+	std::vector<ElementRef<Edge>> upEdges;
+	std::vector<ElementRef<Face>> sideFaces;
+	std::vector<ElementRef<Face>> capFaces;
 
+	std::vector<ElementRef<Vertice>> movedVerts;
+	std::vector<glm::vec3> movedBy;
 
-	Vertice* oldVerts[4]{nullptr,nullptr,nullptr,nullptr};
-	Edge* oldEdges[4]{nullptr,nullptr,nullptr,nullptr};
+	// the faces the caps replaced, flattened : face i held oldSides[i] entries
+	std::vector<ElementRef<Vertice>> oldVerts;
+	std::vector<ElementRef<Edge>> oldEdges;
+	std::vector<uint32_t> oldSides;
 
 	float distance{0.f};
 };
 
 
+// one record per Mesh::beginEdit / commitEdit transaction. Elements the edit
+// made are listed so a rewind can remove them; elements it moved, rewired or
+// retired are kept as they were before it, so a rewind can put them back.
+// Refs are stamped like ExtrudeRecord's : a retired element resolves to
+// nullptr and is rebuilt from its entry
+struct TopologyEditRecord
+{
+	std::vector<ElementRef<Vertice>> addedVerts;
+	std::vector<ElementRef<Edge>> addedEdges;
+	std::vector<ElementRef<Face>> addedFaces;
+
+	std::vector<ElementRef<Vertice>> oldVerts;
+	std::vector<glm::vec3> oldPositions;
+	std::vector<uint8_t> vertRetired;
+
+	// two ends per edge
+	std::vector<ElementRef<Edge>> oldEdges;
+	std::vector<ElementRef<Vertice>> oldEdgeEnds;
+	std::vector<uint8_t> edgeRetired;
+
+	// flattened : face i held oldSides[i] corners, oldKinds[i] is its FaceKind
+	std::vector<ElementRef<Face>> oldFaces;
+	std::vector<ElementRef<Vertice>> oldFaceVerts;
+	std::vector<ElementRef<Edge>> oldFaceEdges;
+	std::vector<uint32_t> oldSides;
+	std::vector<uint8_t> oldKinds;
+	std::vector<uint8_t> faceRetired;
+
+	// net element count change, shown in the history
+	int64_t verticeDelta{0};
+	int64_t edgeDelta{0};
+	int64_t faceDelta{0};
+};
+
+// what Mesh::revertTopologyEdit made again for retired elements : the retired
+// element's ref, then the copy standing in for it. Older records still name
+// the retired element, the rewind points them at the copy
+struct RevivedElements
+{
+	std::vector<std::pair<ElementRef<Vertice>, ElementRef<Vertice>>> verts;
+	std::vector<std::pair<ElementRef<Edge>, ElementRef<Edge>>> edges;
+	std::vector<std::pair<ElementRef<Face>, ElementRef<Face>>> faces;
+};
+
+
 struct MeshTransformEvent 
 {
 	glm::mat4 delta{1.0f};
@@ -43,9 +98,11 @@ struct MeshTransformEvent
 	bool isComponentEdit{false}; 
 
 	ComponentEditKind kind{ComponentEditKind::None};
-	std::vector<Vertice*> affectedVertices;
+	// stamped with Mesh::makeRef : a vertex freed since, by a weld say, resolves to nullptr
+	std::vector<ElementRef<Vertice>> affectedVertices;
 
 	ExtrudeRecord extrude{};
+	TopologyEditRecord topology{};
 	uint64_t transformID{0};
 
 };
@@ -53,7 +110,6 @@ struct MeshTransformEvent
 struct SnapshotVertice {
 	Vertice* ptr{nullptr};
 	glm::vec3 local{0.0f};
-	glm::vec3 world{0.0f};
 };
 
 
@@ -67,10 +123,11 @@ public:
 	void track(const glm::mat4& delta, uint64_t tick = 0, const std::string& tag = {});
 	void trackWithAutoTick(const glm::mat4& delta, const std::string& tag);
 	void trackWithTransformID(const glm::mat4& delta, const std::string& tag, uint64_t transformID);
-	void trackEdgeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts);
-	void trackVerticeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts);
-	void trackFaceModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts);
-	void trackExtrude(const ExtrudeRecord& rec);
+	void trackEdgeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts, const Mesh* mesh);
+	void trackVerticeModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts, const Mesh* mesh);
+	void trackFaceModify(const glm::mat4& deltaWorld, const std::vector<Vertice*>& verts, const Mesh* mesh);
+	void trackExtrude(ExtrudeRecord rec);
+	void trackTopologyEdit(const std::string& tag, TopologyEditRecord rec);
 
 	glm::mat4 accumulated() const;
 	const std::vector<MeshTransformEvent>& getHistory() const; 
@@ -78,10 +135,11 @@ public:
 	glm::mat4 accumulatedUpTo(size_t count) const;
 
 	void rewindToAndApply(size_t index_inclusive, Mesh* mesh);
-	void rewindEdgeHistory(size_t index_inclusive, Mesh* mesh);
-	void rewindVerticeHistory(size_t index_inclusive, Mesh* mesh);
-	void rewindFaceHistory(size_t index_inclusive, Mesh* mesh);
 	void rewindExtrudeHistory(size_t index_inclusive, Mesh* mesh);
+	// undoes every component edit after index_inclusive in one pass, newest
+	// first : vertex / edge / face moves, extrusions and topology edits may
+	// each have been made over the others' elements
+	void rewindComponentHistory(size_t index_inclusive, Mesh* mesh);
 	
 
 	bool cancelTransformByID(uint64_t transformID, Mesh* mesh);